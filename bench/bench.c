@@ -0,0 +1,1644 @@
+/**
+ * Benchmarks for the library CMD Friend.
+ *
+ * The library source is included directly so the internal tables can be measured on their own,
+ * without the registration rules that limit how many options a real program can register.
+ *
+ * The parser is also measured against glibc "getopt_long" and "argp", running the same options spec through the three
+ * of them, so glibc is needed. Every allocation of the process is counted by replacing malloc, and the peak resident
+ * memory is read from procfs.
+ *
+ * Build and run with "make bench", or "make bench BENCH="argc keys"" to run only some of the sections.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <getopt.h>
+#include <argp.h>
+#include <gnu/libc-version.h>
+
+// argp flag macros with the names of cmdf option parameters, the argp flags are not used here
+#undef OPTION_ALIAS
+#undef OPTION_HIDDEN
+
+#include "../src/cmdf.c"
+
+
+/* Helpers -------------------------------------------------------------------------------- */
+
+
+// monotonic time in nanoseconds
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+
+// value sink so the compiler can't drop the measured lookups
+static volatile size_t bench_sink;
+
+
+static FILE *bench_null; // help texts and completions are written here
+
+
+static int bench_failures; // sections that found a regression, the process then exits with 1
+
+
+// every allocation of the process, the library and glibc included, goes through these to be counted
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t count, size_t size);
+extern void *__libc_realloc(void *pointer, size_t size);
+extern void __libc_free(void *pointer);
+
+static size_t bench_allocations;
+
+
+void *malloc(size_t size)
+{
+    bench_allocations++;
+    return __libc_malloc(size);
+}
+
+
+void *calloc(size_t count, size_t size)
+{
+    bench_allocations++;
+    return __libc_calloc(count, size);
+}
+
+
+void *realloc(void *pointer, size_t size)
+{
+    bench_allocations++;
+    return __libc_realloc(pointer, size);
+}
+
+
+void free(void *pointer)
+{
+    __libc_free(pointer);
+}
+
+
+// a field of /proc/self/status in KiB, 0 when there is no procfs
+static long status_kib(const char *field)
+{
+    FILE *status = fopen("/proc/self/status", "r");
+    size_t length = strlen(field);
+    char line[256];
+    long value = 0;
+
+    if(status == NULL)
+        return 0;
+
+    while(fgets(line, sizeof(line), status) != NULL)
+    {
+        if(!strncmp(line, field, length) && line[length] == ':')
+        {
+            value = strtol(line + length + 1, NULL, 10);
+            break;
+        }
+    }
+
+    fclose(status);
+    return value;
+}
+
+
+// lowers the peak resident memory of the process to the current one, so every run can report its own peak
+static void peak_memory_reset(void)
+{
+    FILE *clear_refs = fopen("/proc/self/clear_refs", "w");
+
+    if(clear_refs != NULL)
+    {
+        fputs("5", clear_refs);
+        fclose(clear_refs);
+    }
+}
+
+
+// makes an options array with "count" synthetic long names, ended by an empty option
+static cmdf_option *make_options(int count)
+{
+    cmdf_option *options = calloc(count + 1, sizeof(*options));
+
+    for(int i = 0; i < count; i++)
+    {
+        char *name = malloc(32);
+        snprintf(name, 32, "option-name-%d", i);
+
+        options[i].long_name = name;
+        options[i].key = 1;
+        options[i].parameters = OPTION_OPTIONAL | OPTION_NO_CHAR_KEY;
+        options[i].description = "Benchmark option";
+    }
+
+    return options;
+}
+
+
+static void free_options(cmdf_option *options)
+{
+    for(int i = 0; options[i].long_name != NULL; i++)
+        free(options[i].long_name);
+
+    free(options);
+}
+
+
+// the sequential search the library used before the long name index, kept as baseline
+static cmdf_option *linear_get_option_by_long_name(char *long_name, cmdf_option *options_array)
+{
+    for(int i = 0; options_array[i].long_name != NULL; i++)
+    {
+        if(!strcmp(long_name, options_array[i].long_name))
+            return &(options_array[i]);
+    }
+
+    return NULL;
+}
+
+
+/* Benchmarks ----------------------------------------------------------------------------- */
+
+
+// cost of one "--name" lookup as the number of registered options grows, with the hash index, the trie of
+// PARSER_FLAG_ALLOW_ABBREVIATIONS given whole names and their shortest abbreviations, and the sequential search
+static void bench_long_name_lookup(void)
+{
+    const int sizes[] = {10, 100, 1000, 10000};
+    const int lookups = 200000;
+
+    printf("long name lookup, ns per lookup\n");
+    printf("%10s %12s %12s %12s %12s\n", "options", "index", "trie", "trie abbrev", "linear");
+
+    for(size_t s = 0; s < sizeof(sizes)/sizeof(sizes[0]); s++)
+    {
+        int count = sizes[s];
+        cmdf_option *options = make_options(count);
+        cmdf_long_name_index index;
+        cmdf_name_trie trie;
+        char **queries = malloc(sizeof(*queries) * lookups);
+        char **abbreviations = malloc(sizeof(*abbreviations) * count);
+        double start, index_ns, trie_ns, abbreviation_ns, linear_ns;
+        int linear_lookups = (count > 1000) ? lookups / 100 : lookups; // the linear scan is too slow to run in full
+        unsigned int node;
+
+        long_name_index_build(&index, options, &default_allocator);
+        name_trie_build(&trie, options, &default_allocator);
+
+        for(int i = 0; i < lookups; i++)
+            queries[i] = options[(i * 7919) % count].long_name;
+
+        // the shortest start of every name that only names its option, the whole name when it starts other names
+        for(int i = 0; i < count; i++)
+        {
+            abbreviations[i] = strdup(options[i].long_name);
+
+            for(size_t length = 1; length < strlen(options[i].long_name); length++)
+            {
+                abbreviations[i][length] = '\0';
+
+                if(name_trie_lookup(&trie, abbreviations[i], '\0', &node) == i)
+                    break;
+
+                abbreviations[i][length] = options[i].long_name[length];
+            }
+        }
+
+        start = now_ns();
+        for(int i = 0; i < lookups; i++)
+            bench_sink += (size_t)get_option_by_long_name(queries[i], &index);
+        index_ns = (now_ns() - start) / lookups;
+
+        start = now_ns();
+        for(int i = 0; i < lookups; i++)
+            bench_sink += (size_t)name_trie_lookup(&trie, queries[i], '\0', &node);
+        trie_ns = (now_ns() - start) / lookups;
+
+        start = now_ns();
+        for(int i = 0; i < lookups; i++)
+            bench_sink += (size_t)name_trie_lookup(&trie, abbreviations[((long long)i * 7919) % count], '\0', &node);
+        abbreviation_ns = (now_ns() - start) / lookups;
+
+        start = now_ns();
+        for(int i = 0; i < linear_lookups; i++)
+            bench_sink += (size_t)linear_get_option_by_long_name(queries[i], options);
+        linear_ns = (now_ns() - start) / linear_lookups;
+
+        printf("%10d %12.1f %12.1f %12.1f %12.1f\n", count, index_ns, trie_ns, abbreviation_ns, linear_ns);
+
+        for(int i = 0; i < count; i++)
+            free(abbreviations[i]);
+
+        long_name_index_free(&index, &default_allocator);
+        name_trie_free(&trie, &default_allocator);
+        free(abbreviations);
+        free(queries);
+        free_options(options);
+    }
+
+    printf("\n");
+}
+
+
+// expands a response file with one million arguments, then parses them with a single option that takes them all
+static int bench_count_parse(char key, char *arg, int arg_pos, void *user)
+{
+    if(key == 'f')
+        *(int*)user += (arg[0] != '\0');
+
+    return 0;
+}
+
+
+static void bench_response_file(void)
+{
+    const int entries = 1000000;
+    const char *path = "bench_response_file.txt";
+    FILE *file = fopen(path, "w");
+    cmdf_option options[] = {{"files", 'f', OPTION_OPTIONAL, -1, "Input files"}, {0}};
+    char response_argument[64];
+    char *argv[] = {"bench", "-f", response_argument};
+    cmdf_parser *parser;
+    cmdf_args args;
+    double start, expand_ns, parse_ns;
+    int parsed = 0;
+
+    if(file == NULL)
+        return;
+
+    for(int i = 0; i < entries; i++)
+        fprintf(file, (i % 2) ? "\"input file %d.txt\"\n" : "input-file-%d.txt\n", i);
+
+    fclose(file);
+    snprintf(response_argument, sizeof(response_argument), "@%s", path);
+
+    parser = cmdf_parser_create(options, 0);
+
+    start = now_ns();
+    cmdf_args_expand(&args, 3, argv, NULL);
+    expand_ns = now_ns() - start;
+
+    start = now_ns();
+    cmdf_parser_parse(parser, bench_count_parse, args.argc, args.argv, &parsed);
+    parse_ns = now_ns() - start;
+
+    printf("response file, %d arguments\n", entries);
+    printf("%10s %12.1f ms %8.1f ns/arg\n", "expand", expand_ns / 1e6, expand_ns / entries);
+    printf("%10s %12.1f ms %8.1f ns/arg\n", "parse", parse_ns / 1e6, parse_ns / entries);
+    printf("%10s %12d\n\n", "parsed", parsed);
+
+    cmdf_args_free(&args);
+    cmdf_parser_free(parser);
+    remove(path);
+}
+
+
+// parses one million NUL delimited arguments read from a file descriptor, with the constant size stream buffer
+static void bench_stream(void)
+{
+    const int entries = 1000000;
+    const char *path = "bench_stream.bin";
+    FILE *file = fopen(path, "wb");
+    cmdf_option options[] = {{"files", 'f', OPTION_OPTIONAL, -1, "Input files"}, {0}};
+    cmdf_parser *parser;
+    double start, parse_ns;
+    int parsed = 0;
+    int descriptor;
+
+    if(file == NULL)
+        return;
+
+    fprintf(file, "-f%c", 0);
+    for(int i = 0; i < entries; i++)
+        fprintf(file, "input-file-%d.txt%c", i, 0);
+
+    fclose(file);
+
+    parser = cmdf_parser_create(options, 0);
+    descriptor = open(path, O_RDONLY);
+
+    start = now_ns();
+    cmdf_parser_parse_fd(parser, bench_count_parse, descriptor, '\0', &parsed, NULL);
+    parse_ns = now_ns() - start;
+
+    printf("stream, %d arguments, %d bytes buffer\n", entries, CMDF_STREAM_BUFFER_LENGTH);
+    printf("%10s %12.1f ms %8.1f ns/arg\n", "parse", parse_ns / 1e6, parse_ns / entries);
+    printf("%10s %12d\n\n", "parsed", parsed);
+
+    close(descriptor);
+    cmdf_parser_free(parser);
+    remove(path);
+}
+
+
+// splits command strings of a few kilobytes with the SSE2 scan and with the scalar scan
+static void bench_tokenizer(void)
+{
+    const size_t sizes[] = {1024, 4096, 16384, 65536};
+    const char *pieces[] = {"--option-name ", "/usr/local/share/some/long/path/file.txt ", "'single quoted value' ",
+                            "\"double \\\"quoted\\\" value\" ", "-v ", "escaped\\ space "};
+
+    printf("tokenizer, ns per KiB of command string\n");
+    printf("%10s %10s %12s %12s\n", "bytes", "tokens", "vectorized", "scalar");
+
+    for(size_t s = 0; s < sizeof(sizes)/sizeof(sizes[0]); s++)
+    {
+        size_t size = sizes[s];
+        char *source = malloc(size + 64);
+        char *command = malloc(size + 64);
+        size_t length = 0;
+        int repeats = (int)(64 * 1024 * 1024 / size);
+        int tokens = 0;
+        double times[2];
+
+        for(int p = 0; length < size; p = (p + 1) % 6)
+        {
+            strcpy(source + length, pieces[p]);
+            length += strlen(pieces[p]);
+        }
+
+        for(int vectorized = 1; vectorized >= 0; vectorized--)
+        {
+            double start = now_ns();
+
+            for(int r = 0; r < repeats; r++)
+            {
+                char *cursor = command, *token;
+                int literal;
+
+                memcpy(command, source, length + 1); // the split is in place, every round starts from a fresh copy
+                tokens = 0;
+
+                while((token = command_token_next(&cursor, command + length, &literal, vectorized)) != NULL)
+                    tokens++;
+            }
+
+            times[1 - vectorized] = (now_ns() - start) / repeats / ((double)length / 1024);
+        }
+
+        printf("%10zu %10d %12.1f %12.1f\n", length, tokens, times[0], times[1]);
+
+        free(source);
+        free(command);
+    }
+
+    printf("\n");
+}
+
+
+// the same options parsed with bindings and with a parse function converting with the C library
+typedef struct
+{
+    int verbose;
+    long number;
+    double ratio;
+    unsigned long long size;
+}bench_values;
+
+
+static int bench_values_parse(char key, char *arg, int arg_pos, void *user)
+{
+    bench_values *values = (bench_values*)user;
+    char *end;
+
+    switch(key)
+    {
+        case 'v': values->verbose = 1; break;
+        case 'n': values->number = strtol(arg, NULL, 10); break;
+        case 'r': values->ratio = strtod(arg, NULL); break;
+        case 's':
+            values->size = strtoull(arg, &end, 10);
+            if(*end == 'k')
+                values->size <<= 10;
+            break;
+        default: break;
+    }
+
+    return 0;
+}
+
+
+static void bench_bindings(void)
+{
+    const int parses = 1000000;
+    cmdf_option bound_options[] =
+    {
+        {"verbose", 'v', OPTION_OPTIONAL, 0, "Verbose", CMDF_BIND_FLAG(bench_values, verbose)},
+        {"number",  'n', OPTION_OPTIONAL, 1, "Number", CMDF_BIND_INT(bench_values, number, 0, 0)},
+        {"ratio",   'r', OPTION_OPTIONAL, 1, "Ratio", CMDF_BIND_FLOAT(bench_values, ratio)},
+        {"size",    's', OPTION_OPTIONAL, 1, "Size", CMDF_BIND_SIZE(bench_values, size, 0, 0)},
+        {0}
+    };
+    cmdf_option callback_options[] =
+    {
+        {"verbose", 'v', OPTION_OPTIONAL, 0, "Verbose"},
+        {"number",  'n', OPTION_OPTIONAL, 1, "Number"},
+        {"ratio",   'r', OPTION_OPTIONAL, 1, "Ratio"},
+        {"size",    's', OPTION_OPTIONAL, 1, "Size"},
+        {0}
+    };
+    char *argv[] = {"bench", "-v", "--number", "123456", "-r", "0.125", "--size", "64k"};
+    int argc = sizeof(argv) / sizeof(argv[0]);
+    cmdf_parser *bound = cmdf_parser_create(bound_options, 0);
+    cmdf_parser *callback = cmdf_parser_create(callback_options, 0);
+    bench_values values;
+    double start, bound_ns, callback_ns;
+
+    start = now_ns();
+    for(int i = 0; i < parses; i++)
+    {
+        memset(&values, 0, sizeof(values));
+        cmdf_parser_parse(bound, NULL, argc, argv, &values);
+        bench_sink += values.size;
+    }
+    bound_ns = (now_ns() - start) / parses;
+
+    start = now_ns();
+    for(int i = 0; i < parses; i++)
+    {
+        memset(&values, 0, sizeof(values));
+        cmdf_parser_parse(callback, bench_values_parse, argc, argv, &values);
+        bench_sink += values.size;
+    }
+    callback_ns = (now_ns() - start) / parses;
+
+    printf("bindings, ns per command line of %d arguments\n", argc - 1);
+    printf("%12s %12s\n", "bindings", "callback");
+    printf("%12.1f %12.1f\n\n", bound_ns, callback_ns);
+
+    cmdf_parser_free(bound);
+    cmdf_parser_free(callback);
+}
+
+
+// "Did you mean" suggestions for misspelled long names, with the bigram index and comparing every name
+static const char *bench_words[] =
+{
+    "cache", "size", "output", "input", "format", "level", "verbose", "color", "thread", "count",
+    "timeout", "retry", "buffer", "memory", "limit", "path", "config", "debug", "trace", "log",
+    "server", "client", "port", "host", "proxy", "user", "group", "mode", "style", "theme",
+    "index", "search", "filter", "sort", "order", "width", "height", "depth", "quality", "compress"
+};
+
+
+// a name made of three words, different for every "i" up to 64000
+static void bench_word_name(char *name, size_t size, int i)
+{
+    const int words = sizeof(bench_words) / sizeof(bench_words[0]);
+
+    snprintf(name, size, "%s-%s-%s", bench_words[i % words], bench_words[(i / words) % words], bench_words[(i / words / words) % words]);
+}
+
+
+static void bench_suggest(void)
+{
+    const int sizes[] = {100, 1000, 10000};
+    const int queries_len = 10000;
+
+    printf("suggestions, ns per misspelled name\n");
+    printf("%10s %12s %12s %12s %10s\n", "options", "build us", "index", "every name", "found");
+
+    for(size_t s = 0; s < sizeof(sizes)/sizeof(sizes[0]); s++)
+    {
+        int count = sizes[s];
+        cmdf_option *options = make_options(count);
+        char (*queries)[64] = malloc(sizeof(*queries) * queries_len);
+        cmdf_parser *parser;
+        cmdf_suggest_index *index;
+        unsigned int random = 12345;
+        double start, build_ns, index_ns, scan_ns;
+        int found = 0;
+
+        for(int i = 0; i < count; i++)
+            bench_word_name(options[i].long_name, 32, i * 7);
+
+        // one edit on each name: a char removed, changed, or swapped with the next one
+        for(int q = 0; q < queries_len; q++)
+        {
+            char *query = queries[q];
+            size_t length, position;
+
+            random = random * 1103515245 + 12345;
+            strcpy(query, options[(random >> 8) % count].long_name);
+            length = strlen(query);
+            position = (random >> 4) % (length - 1);
+
+            switch((random >> 20) % 3)
+            {
+                case 0: memmove(query + position, query + position + 1, length - position); break;
+                case 1: query[position] = (char)('a' + (random >> 12) % 26); break;
+                default: { char c = query[position]; query[position] = query[position + 1]; query[position + 1] = c; } break;
+            }
+        }
+
+        parser = cmdf_parser_create(options, PARSER_FLAG_NOT_EXIT_ON_ERROR);
+
+        start = now_ns();
+        index = suggest_index_build(parser, &default_allocator);
+        build_ns = now_ns() - start;
+        suggest_index_free(index, &default_allocator);
+
+        bench_sink += (size_t)suggest_option(parser, queries[0], strlen(queries[0])); // builds the cached index
+
+        start = now_ns();
+        for(int q = 0; q < queries_len; q++)
+        {
+            const cmdf_option *suggestion = suggest_option(parser, queries[q], strlen(queries[q]));
+
+            found += (suggestion != NULL);
+            bench_sink += (size_t)suggestion;
+        }
+        index_ns = (now_ns() - start) / queries_len;
+
+        start = now_ns();
+        for(int q = 0; q < queries_len; q++)
+        {
+            size_t length = strlen(queries[q]);
+            int bound = (length <= SUGGEST_SHORT_LENGTH) ? 1 : SUGGEST_MAX_DISTANCE;
+            int best = bound + 1;
+
+            for(int i = 0; i < parser->options_len; i++)
+            {
+                int distance = suggest_distance(queries[q], length, parser->options[i].long_name, strlen(parser->options[i].long_name), bound);
+
+                if(distance < best)
+                    best = distance;
+            }
+
+            bench_sink += best;
+        }
+        scan_ns = (now_ns() - start) / queries_len;
+
+        printf("%10d %12.1f %12.1f %12.1f %10d\n", count, build_ns / 1e3, index_ns, scan_ns, found);
+
+        cmdf_parser_free(parser);
+        free(queries);
+        free_options(options);
+    }
+
+    printf("\n");
+}
+
+
+// a git-style program with many subcommands of 20 options each, a command line selecting one of them. The tree compiles
+// only the root and the selected command, against compiling every command when the program starts
+static void bench_commands(void)
+{
+    const int sizes[] = {10, 150, 1000};
+    const int options_len = 20;
+    const int runs = 2000;
+
+    printf("commands, us per command line \"tool --verbose command-7 --option-name-3 x\"\n");
+    printf("%10s %12s %12s %12s\n", "commands", "tree", "tree warm", "every table");
+
+    for(size_t s = 0; s < sizeof(sizes)/sizeof(sizes[0]); s++)
+    {
+        int count = sizes[s];
+        cmdf_option root_options[] = {{"verbose", 'v', OPTION_OPTIONAL, 0, "Verbose"}, {0}};
+        cmdf_command *commands = calloc(count + 1, sizeof(*commands));
+        cmdf_command root = {"tool", root_options, NULL, NULL, NULL, commands};
+        char *argv[] = {"tool", "--verbose", "command-7", "--option-name-3", "x"};
+        cmdf_command_tree *tree;
+        cmdf_result result;
+        double start, tree_ns, warm_ns, eager_ns;
+
+        for(int i = 0; i < count; i++)
+        {
+            char *name = malloc(32);
+
+            snprintf(name, 32, "command-%d", i);
+            commands[i].name = name;
+            commands[i].options = make_options(options_len);
+            commands[i].description = "Benchmark command";
+
+            for(int o = 0; o < options_len; o++)
+            {
+                commands[i].options[o].key = (char)(1 + o); // keys that are not letters, none shared with the root
+                commands[i].options[o].argq = 1;
+            }
+        }
+
+        // a whole run of the program: the tree made, one command line parsed, the tree released
+        start = now_ns();
+        for(int r = 0; r < runs; r++)
+        {
+            tree = cmdf_command_tree_create(&root, PARSER_FLAG_NOT_EXIT_ON_ERROR);
+            bench_sink += (size_t)cmdf_command_tree_parse(tree, 5, argv, NULL, &result, NULL);
+            cmdf_command_tree_free(tree);
+        }
+        tree_ns = (now_ns() - start) / runs;
+
+        tree = cmdf_command_tree_create(&root, PARSER_FLAG_NOT_EXIT_ON_ERROR);
+
+        if(cmdf_command_tree_parse(tree, 5, argv, NULL, &result, NULL) != PARSER_ERROR_NONE)
+            printf("%10d commands parse failed\n", count);
+
+        start = now_ns();
+        for(int r = 0; r < runs; r++)
+            bench_sink += (size_t)cmdf_command_tree_parse(tree, 5, argv, NULL, &result, NULL);
+        warm_ns = (now_ns() - start) / runs;
+
+        cmdf_command_tree_free(tree);
+
+        // every command compiled up front, then the same parse
+        start = now_ns();
+        for(int r = 0; r < runs / 10; r++)
+        {
+            cmdf_command_path root_path = {&root, NULL, NULL};
+
+            tree = cmdf_command_tree_create(&root, PARSER_FLAG_NOT_EXIT_ON_ERROR);
+            const cmdf_parser *root_parser = command_tree_parser_get(tree, NULL, &root_path);
+
+            for(int i = 0; i < count; i++)
+            {
+                cmdf_command_path path = {&(commands[i]), &root_path, NULL};
+
+                bench_sink += (size_t)command_tree_parser_get(tree, root_parser, &path);
+            }
+
+            bench_sink += (size_t)cmdf_command_tree_parse(tree, 5, argv, NULL, &result, NULL);
+            cmdf_command_tree_free(tree);
+        }
+        eager_ns = (now_ns() - start) / (runs / 10);
+
+        printf("%10d %12.2f %12.2f %12.2f\n", count, tree_ns / 1e3, warm_ns / 1e3, eager_ns / 1e3);
+
+        for(int i = 0; i < count; i++)
+        {
+            free((char*)commands[i].name);
+            free_options(commands[i].options);
+        }
+
+        free(commands);
+    }
+
+    printf("\n");
+}
+
+
+// one TAB press completing "--option-name-<n>" as the shell asks it, written to /dev/null. Every press runs the program
+// again, so a runtime parser pays its creation and a query comparing every name, the "cold TAB"; building the trie would
+// cost more than the one query it serves. Generated parsers pay neither, their trie is in their tables and they answer as
+// the "trie" column, measured on a trie built ahead as the generator does. "first query" builds the trie, as the first
+// "cmdf_parser_complete" of a program does
+static void bench_complete(void)
+{
+    const int sizes[] = {100, 1000, 10000};
+    const int queries_len = 2000;
+
+    printf("completion, us per TAB\n");
+    printf("%10s %12s %12s %12s %12s %12s %10s\n", "options", "create", "scan", "cold TAB", "first query", "trie", "found");
+
+    for(size_t s = 0; s < sizeof(sizes)/sizeof(sizes[0]); s++)
+    {
+        int count = sizes[s];
+        cmdf_option *options = make_options(count);
+        char (*queries)[32] = malloc(sizeof(*queries) * queries_len);
+        char *words[2] = {"bench", NULL};
+        cmdf_parser *parser;
+        double start, create_ns, scan_ns, first_ns, query_ns;
+        int found = 0, scanned = 0;
+
+        for(int i = 0; i < count; i++)
+            options[i].key = (char)(1 + i % 120); // keys are not checked here, the registration errors are cleared below
+
+        for(int q = 0; q < queries_len; q++)
+            snprintf(queries[q], sizeof(queries[q]), "--option-name-%d", (int)(((long long)q * 7919) % count) / 10 + 1);
+
+        start = now_ns();
+        parser = cmdf_parser_create(options, PARSER_FLAG_NOT_EXIT_ON_ERROR | PARSER_FLAG_ENABLE_COMPLETION);
+        create_ns = now_ns() - start;
+        parser->registration_result.error_count = 0;
+
+        // the query of "complete_main", the parser has no trie so the names are compared
+        start = now_ns();
+        for(int q = 0; q < queries_len; q++)
+        {
+            unsigned long passed[parser->bitset_words];
+
+            memset(passed, 0, sizeof(passed));
+            words[1] = queries[q];
+            scanned += complete_walk(NULL, NULL, parser, passed, words, 1, 1, queries[q], 0, bench_null);
+        }
+        scan_ns = (now_ns() - start) / queries_len;
+
+        words[1] = queries[0];
+        start = now_ns();
+        bench_sink += cmdf_parser_complete(parser, 1, 2, words, bench_null);
+        first_ns = now_ns() - start;
+
+        start = now_ns();
+        for(int q = 0; q < queries_len; q++)
+        {
+            words[1] = queries[q];
+            found += cmdf_parser_complete(parser, 1, 2, words, bench_null);
+        }
+        query_ns = (now_ns() - start) / queries_len;
+
+        printf("%10d %12.1f %12.2f %12.1f %12.1f %12.2f %10s\n", count, create_ns / 1e3, scan_ns / 1e3, (create_ns + scan_ns) / 1e3, first_ns / 1e3, query_ns / 1e3,
+               (found == scanned) ? "same" : "DIFFERENT");
+
+        bench_failures += (found != scanned);
+
+        cmdf_parser_free(parser);
+        free(queries);
+        free_options(options);
+    }
+
+    printf("\n");
+}
+
+
+// the same 40 options given on argv, by environment variables and by a config file, the last two loaded once
+static int bench_config_parse(char key, char *arg, int arg_pos, void *user)
+{
+    *(int*)user += (arg != NULL);
+
+    return 0;
+}
+
+
+static void bench_config(void)
+{
+    const int count = 40;
+    const int parses = 100000;
+    const char *path = "bench_config.conf";
+    FILE *file = fopen(path, "w");
+    cmdf_parser *parser;
+    double start, load_ns, argv_ns, env_ns, config_ns;
+    int given[3] = {0, 0, 0};
+
+    if(file == NULL)
+        return;
+
+    cmdf_option *options = make_options(count);
+    char **argv = calloc(2 * count + 2, sizeof(*argv));
+    char (*env_names)[32] = malloc(sizeof(*env_names) * count);
+    char (*values)[32] = malloc(sizeof(*values) * count);
+
+    argv[0] = "bench";
+
+    for(int o = 0; o < count; o++)
+    {
+        options[o].key = (char)(1 + o);
+        options[o].argq = 1;
+        snprintf(values[o], sizeof(values[o]), "value-%d", o);
+        snprintf(env_names[o], sizeof(env_names[o]), "BENCH_OPTION_%d", o);
+        argv[1 + 2 * o] = malloc(48);
+        snprintf(argv[1 + 2 * o], 48, "--%s", options[o].long_name);
+        argv[2 + 2 * o] = values[o];
+        fprintf(file, "%s = %s\n", options[o].long_name, values[o]);
+    }
+
+    fclose(file);
+    parser = cmdf_parser_create(options, 0);
+
+    start = now_ns();
+    cmdf_parser_set_config_file(parser, path);
+    load_ns = now_ns() - start;
+
+    start = now_ns();
+    for(int p = 0; p < parses; p++)
+        cmdf_parser_parse(parser, bench_config_parse, 2 * count + 1, argv, &given[0]);
+    argv_ns = (now_ns() - start) / parses;
+
+    start = now_ns();
+    for(int p = 0; p < parses; p++)
+        cmdf_parser_parse(parser, bench_config_parse, 1, argv, &given[2]);
+    config_ns = (now_ns() - start) / parses;
+
+    cmdf_parser_free(parser);
+
+    // the environment layer, a parser whose options name a variable each
+    for(int o = 0; o < count; o++)
+    {
+        options[o].env_name = env_names[o];
+        setenv(env_names[o], values[o], 1);
+    }
+
+    parser = cmdf_parser_create(options, 0);
+
+    start = now_ns();
+    for(int p = 0; p < parses; p++)
+        cmdf_parser_parse(parser, bench_config_parse, 1, argv, &given[1]);
+    env_ns = (now_ns() - start) / parses;
+
+    for(int o = 0; o < count; o++)
+        unsetenv(env_names[o]);
+
+    printf("%d options given by argv, environment and config file, us per parse\n", count);
+    printf("%10s %12s %12s %12s %12s\n", "load file", "argv", "environment", "config file", "given");
+    printf("%10.1f %12.2f %12.2f %12.2f %4d %3d %3d\n\n", load_ns / 1e3, argv_ns / 1e3, env_ns / 1e3, config_ns / 1e3, given[0] / parses, given[1] / parses, given[2] / parses);
+
+    cmdf_parser_free(parser);
+
+    for(int o = 0; o < count; o++)
+        free(argv[1 + 2 * o]);
+
+    free(argv);
+    free(env_names);
+    free(values);
+    free_options(options);
+    remove(path);
+}
+
+
+// one option taking a million arguments, given to the parse function one at a time or to a span function at once
+static int bench_span_count(char key, char **args, int count, void *user)
+{
+    for(int i = 0; i < count; i++)
+        *(int*)user += (args[i][0] != '\0');
+
+    return 0;
+}
+
+
+static void bench_spans(void)
+{
+    const int entries = 1000000;
+    cmdf_option options[] = {{"files", 'f', OPTION_OPTIONAL, -1, "Input files"}, {0}};
+    char **argv = malloc(sizeof(*argv) * (entries + 3));
+    cmdf_parser *parser = cmdf_parser_create(options, 0);
+    double start, each_ns, span_ns;
+    int parsed[2] = {0, 0};
+
+    argv[0] = "bench";
+    argv[1] = "-f";
+
+    for(int i = 0; i < entries; i++)
+        argv[2 + i] = (i % 2) ? "input-file.txt" : "other-file.txt";
+
+    argv[entries + 2] = NULL;
+
+    start = now_ns();
+    cmdf_parser_parse(parser, bench_count_parse, entries + 2, argv, &parsed[0]);
+    each_ns = now_ns() - start;
+
+    cmdf_parser_set_span_function(parser, bench_span_count);
+
+    start = now_ns();
+    cmdf_parser_parse(parser, bench_count_parse, entries + 2, argv, &parsed[1]);
+    span_ns = now_ns() - start;
+
+    printf("option with %d arguments\n", entries);
+    printf("%10s %12.1f ms %8.2f ns/arg %10d\n", "each", each_ns / 1e6, each_ns / entries, parsed[0]);
+    printf("%10s %12.1f ms %8.2f ns/arg %10d\n\n", "span", span_ns / 1e6, span_ns / entries, parsed[1]);
+
+    cmdf_parser_free(parser);
+    free(argv);
+}
+
+
+// parses giving 16 options to parsers whose options are all in exclusive groups of 8, with and without the constraints
+static void bench_constraints(void)
+{
+    const int counts[] = {64, 512, 4096};
+    const int group = 8;
+    const int given = 16;
+    const int parses = 100000;
+    char *argv[1 + 16];
+
+    printf("parses of up to %d options, groups of %d exclusive options, us per parse\n", given, group);
+    printf("%10s %12s %12s %12s %12s %10s\n", "options", "compile", "plain", "constraints", "ns/group", "errors");
+
+    for(size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++)
+    {
+        int count = counts[c];
+        int groups = count / group;
+        cmdf_option *options = make_options(count);
+        cmdf_constraint *constraints = calloc(groups + 1, sizeof(*constraints));
+        cmdf_parser *parser = cmdf_parser_create(options, PARSER_FLAG_NOT_EXIT_ON_ERROR);
+        double start, compile_ns, plain_ns, checked_ns;
+        cmdf_result result;
+        int given_len = (groups < given) ? groups : given;
+        int errors = 0, sink = 0;
+
+        parser->registration_result.error_count = 0; // the keys are all the same, that is not checked here
+
+        for(int g = 0; g < groups; g++)
+        {
+            char *names = malloc(32 * group);
+            size_t used = 0;
+
+            for(int o = 0; o < group; o++)
+                used += (size_t)snprintf(names + used, 32 * group - used, "%s%s", (o > 0) ? " " : "", options[g * group + o].long_name);
+
+            constraints[g] = (cmdf_constraint){CONSTRAINT_EXCLUSIVE, names};
+        }
+
+        argv[0] = "bench";
+
+        for(int a = 0; a < given_len; a++)
+        {
+            argv[1 + a] = malloc(48);
+            snprintf(argv[1 + a], 48, "--%s", options[a * group].long_name); // one option of each of the first groups
+        }
+
+        start = now_ns();
+        for(int p = 0; p < parses; p++)
+            cmdf_parser_parse(parser, bench_config_parse, 1 + given_len, argv, &sink);
+        plain_ns = (now_ns() - start) / parses;
+
+        start = now_ns();
+        cmdf_parser_set_constraints(parser, constraints);
+        compile_ns = now_ns() - start;
+
+        start = now_ns();
+        for(int p = 0; p < parses; p++)
+            errors += (cmdf_parser_parse_result(parser, bench_config_parse, 1 + given_len, argv, &sink, &result) != PARSER_ERROR_NONE);
+        checked_ns = (now_ns() - start) / parses;
+
+        printf("%10d %12.1f %12.2f %12.2f %12.2f %10d\n", count, compile_ns / 1e3, plain_ns / 1e3, checked_ns / 1e3, (checked_ns - plain_ns) / groups, errors);
+
+        cmdf_parser_free(parser);
+
+        for(int a = 0; a < given_len; a++)
+            free(argv[1 + a]);
+
+        for(int g = 0; g < groups; g++)
+            free((char*)constraints[g].options);
+
+        free(constraints);
+        free_options(options);
+        bench_sink += (size_t)sink;
+    }
+
+    printf("\n");
+}
+
+
+// long only options told apart by their ids with PARSER_FLAG_WIDE_KEYS, no char key needed, and a parse giving each once
+static int bench_wide_count(int32_t id, char *arg, int arg_pos, void *user)
+{
+    *(long long*)user += id;
+
+    return 0;
+}
+
+
+static void bench_wide(void)
+{
+    const int counts[] = {256, 1000, 5000, 20000};
+    const int parses = 20;
+
+    printf("long only options with wide ids, every option given once\n");
+    printf("%10s %12s %12s %12s %10s\n", "options", "create us", "ns/arg", "errors", "id sum ok");
+
+    for(size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++)
+    {
+        int count = counts[c];
+        cmdf_option *options = make_options(count);
+        char **argv = calloc(count + 2, sizeof(*argv));
+        long long sum = 0, expected = 0;
+        cmdf_parser *parser;
+        cmdf_result result;
+        double start, create_ns, parse_ns;
+        int errors = 0;
+
+        argv[0] = "bench";
+
+        for(int o = 0; o < count; o++)
+        {
+            options[o].key = 0; // unused with PARSER_FLAG_WIDE_KEYS
+            argv[1 + o] = malloc(48);
+            snprintf(argv[1 + o], 48, "--%s", options[o].long_name);
+            expected += CMDF_AUTO_ID(o);
+        }
+
+        start = now_ns();
+        parser = cmdf_parser_create(options, PARSER_FLAG_WIDE_KEYS | PARSER_FLAG_NOT_EXIT_ON_ERROR);
+        create_ns = now_ns() - start;
+
+        start = now_ns();
+        for(int p = 0; p < parses; p++)
+            errors += (cmdf_parser_parse_wide(parser, bench_wide_count, count + 1, argv, &sum, &result) != PARSER_ERROR_NONE);
+        parse_ns = (now_ns() - start) / parses;
+
+        printf("%10d %12.1f %12.2f %12d %10s\n", count, create_ns / 1e3, parse_ns / count, errors, (sum == expected * parses) ? "yes" : "no");
+
+        cmdf_parser_free(parser);
+
+        for(int o = 0; o < count; o++)
+            free(argv[1 + o]);
+
+        free(argv);
+        free_options(options);
+    }
+
+    printf("\n");
+}
+
+
+// a command line of each kind parsed by "bench_arena", by its index in "bench_arena_kinds"
+static const char *bench_arena_kinds[] = {"valid", "typo", "ambiguous", "help", "string", "stream"};
+
+
+static void bench_arena_parse(const cmdf_parser *parser, int kind, int *parsed)
+{
+    static char *valid[] = {"bench", "-v", "--output", "out.txt", "--files", "a.txt", "b.txt"};
+    static char *typo[] = {"bench", "--outptu", "out.txt"};
+    static char *ambiguous[] = {"bench", "--option"};
+    static char *help[] = {"bench", "--help=option"};
+    static const char stream[] = "-v\0--files\0a.txt\0b.txt\0--outptu\0";
+    cmdf_result result;
+    char command[64];
+    int pipes[2];
+
+    switch(kind)
+    {
+        case 0: cmdf_parser_parse_result(parser, bench_count_parse, 7, valid, parsed, &result); break;
+        case 1: cmdf_parser_parse_result(parser, bench_count_parse, 3, typo, parsed, &result); break;
+        case 2: cmdf_parser_parse_result(parser, bench_count_parse, 2, ambiguous, parsed, &result); break;
+        case 3: cmdf_parser_parse_result(parser, bench_count_parse, 2, help, parsed, &result); break;
+        case 4:
+            strcpy(command, "-v --files a.txt 'b c.txt' --outptu");
+            cmdf_parser_parse_string(parser, bench_count_parse, command, parsed, &result);
+            break;
+        default:
+            if(pipe(pipes) != 0)
+                return;
+
+            if(write(pipes[1], stream, sizeof(stream) - 1) == (ssize_t)(sizeof(stream) - 1))
+            {
+                close(pipes[1]);
+                cmdf_parser_parse_fd(parser, bench_count_parse, pipes[0], '\0', parsed, &result);
+            }
+            else
+                close(pipes[1]);
+
+            close(pipes[0]);
+            break;
+    }
+}
+
+
+// a parser made on an arena, parsing good command lines, misspelled names, ambiguous abbreviations, "--help=" and streams.
+// The first parse of each kind builds the cached tables, after that a parse allocates nothing, neither from the arena nor
+// with malloc, and the section fails when it does
+static void bench_arena(void)
+{
+    const int parses = 10000;
+    static unsigned char buffer[256 * 1024];
+    cmdf_option options[] =
+    {
+        {"verbose",      'v', OPTION_OPTIONAL, 0,  "Verbose mode"},
+        {"output",       'o', OPTION_OPTIONAL, 1,  "Output file"},
+        {"option-alpha", 'a', OPTION_OPTIONAL, 0,  "First option"},
+        {"option-beta",  'b', OPTION_OPTIONAL, 0,  "Second option"},
+        {"files",        'f', OPTION_OPTIONAL, -1, "Input files"},
+        {0}
+    };
+    cmdf_arena arena;
+    cmdf_allocator allocator;
+    cmdf_parser *parser;
+    int parsed = 0;
+
+    cmdf_arena_init(&arena, buffer, sizeof(buffer));
+    allocator = cmdf_arena_allocator(&arena);
+    parser = cmdf_parser_create_with_allocator(options, PARSER_FLAG_NOT_EXIT_ON_ERROR | PARSER_FLAG_USE_PREDEFINED_OPTIONS |
+                                               PARSER_FLAG_DONT_IGNORE_NON_REGISTERED_OPTIONS | PARSER_FLAG_ALLOW_ABBREVIATIONS, &allocator);
+    cmdf_parser_set_output(parser, bench_null);
+
+    printf("arena parser, %d parses of each command line after the first one\n", parses);
+    printf("%10s %12s %12s %12s %10s\n", "line", "ns/parse", "mallocs", "arena bytes", "no memory");
+
+    for(int k = 0; k < (int)(sizeof(bench_arena_kinds) / sizeof(bench_arena_kinds[0])); k++)
+    {
+        size_t allocations, used;
+        double start, parse_ns;
+
+        bench_arena_parse(parser, k, &parsed);
+
+        allocations = bench_allocations;
+        used = arena.used;
+
+        start = now_ns();
+        for(int p = 0; p < parses; p++)
+            bench_arena_parse(parser, k, &parsed);
+        parse_ns = (now_ns() - start) / parses;
+
+        allocations = bench_allocations - allocations;
+        used = arena.used - used;
+        bench_failures += (allocations != 0 || used != 0);
+
+        printf("%10s %12.1f %12zu %12zu %10s\n", bench_arena_kinds[k], parse_ns, allocations, used, (allocations == 0 && used == 0) ? "yes" : "NO");
+    }
+
+    printf("\n");
+
+    bench_sink += (size_t)parsed;
+    cmdf_parser_free(parser);
+}
+
+
+/* Against getopt_long and argp ----------------------------------------------------------- */
+
+
+#define BENCH_MIN_NS 2e8    // every measure repeats its parse for at least this long
+#define BENCH_LETTERS 52    // options that get a letter key, the others only have a long name
+
+
+// one options spec written for the three parsers, with the same names, keys and number of arguments
+typedef struct
+{
+    int count;                      // number of options
+    int argq;                       // arguments taken by every option, 0, 1 or -1
+    cmdf_option *cmdf;              // ended by an empty option
+    cmdf_parser *parser;            // "cmdf" compiled without the registration checks, that refuse tables this big
+    struct option *getopt;          // ended by an empty option
+    char *short_options;            // optstring of getopt_long, in order as cmdf
+    struct argp_option *argp;       // ended by an empty option
+    struct argp argp_parser;
+    char **names;                   // "--name" argument of every option
+    char **keys;                    // "-k" argument of every option with a letter key
+    char **bundles;                 // "-klmn" argument starting at every option with a letter key
+}bench_spec;
+
+
+// result of a measure
+typedef struct
+{
+    double ns;                      // time per unit, an argument or a help text
+    double allocations;             // allocations per parse
+    long peak_kib;                  // growth of the peak resident memory over the memory in use before the parses
+}bench_measure;
+
+
+typedef void (*bench_run)(const bench_spec *spec, int argc, char **argv);
+
+
+
+
+static int bench_key(int i)
+{
+    if(i >= BENCH_LETTERS)
+        return 1; // long name only, the same key for all as the synthetic tables in "make_options"
+
+    return (i < 26) ? 'a' + i : 'A' + i - 26;
+}
+
+
+static int bench_cmdf_count(char key, char *arg, int arg_pos, void *user)
+{
+    *(size_t*)user += (unsigned char)key + (arg != NULL);
+    return 0;
+}
+
+
+static error_t bench_argp_count(int key, char *arg, struct argp_state *state)
+{
+    if(key >= ARGP_KEY_END) // argp special keys
+        return ARGP_ERR_UNKNOWN;
+
+    *(size_t*)state->input += key + (arg != NULL);
+    return 0;
+}
+
+
+static bench_spec *bench_spec_make(int count, int argq)
+{
+    bench_spec *spec = calloc(1, sizeof(*spec));
+    char *short_option;
+
+    spec->count = count;
+    spec->argq = argq;
+    spec->cmdf = calloc(count + 1, sizeof(*spec->cmdf));
+    spec->getopt = calloc(count + 1, sizeof(*spec->getopt));
+    spec->argp = calloc(count + 1, sizeof(*spec->argp));
+    spec->short_options = short_option = calloc(2 * BENCH_LETTERS + 2, 1);
+    spec->names = calloc(count, sizeof(*spec->names));
+    spec->keys = calloc(count, sizeof(*spec->keys));
+    spec->bundles = calloc(count, sizeof(*spec->bundles));
+
+    *short_option++ = '-'; // non options are returned in order, as cmdf passes them
+
+    for(int i = 0; i < count; i++)
+    {
+        int key = bench_key(i);
+        int letter = (i < BENCH_LETTERS);
+        char *name = malloc(32);
+
+        snprintf(name, 32, "--option-name-%d", i);
+        spec->names[i] = name;
+
+        spec->cmdf[i].long_name = name + 2;
+        spec->cmdf[i].key = (char)key;
+        spec->cmdf[i].parameters = OPTION_OPTIONAL | (letter ? 0 : OPTION_NO_CHAR_KEY);
+        spec->cmdf[i].argq = argq;
+        spec->cmdf[i].description = "Benchmark option";
+
+        spec->getopt[i].name = name + 2;
+        spec->getopt[i].has_arg = (argq == 1) ? required_argument : no_argument;
+        spec->getopt[i].val = letter ? key : 0x100 + i;
+
+        spec->argp[i].name = name + 2;
+        spec->argp[i].key = letter ? key : 0x100 + i;
+        spec->argp[i].arg = (argq == 1) ? "VALUE" : NULL;
+        spec->argp[i].doc = "Benchmark option";
+
+        if(letter)
+        {
+            *short_option++ = (char)key;
+            if(argq == 1)
+                *short_option++ = ':';
+
+            spec->keys[i] = malloc(3);
+            snprintf(spec->keys[i], 3, "-%c", key);
+
+            spec->bundles[i] = malloc(6);
+            snprintf(spec->bundles[i], 6, "-%c%c%c%c", key, bench_key((i + 1) % count % BENCH_LETTERS),
+                     bench_key((i + 2) % count % BENCH_LETTERS), bench_key((i + 3) % count % BENCH_LETTERS));
+        }
+    }
+
+    spec->argp_parser.options = spec->argp;
+    spec->argp_parser.parser = bench_argp_count;
+
+    // the duplicated keys of the options past the letters are the only registration errors, and they don't matter here
+    spec->parser = cmdf_parser_create(spec->cmdf, PARSER_FLAG_NOT_EXIT_ON_ERROR);
+    memset(&spec->parser->registration_result, 0, sizeof(spec->parser->registration_result));
+
+    return spec;
+}
+
+
+static void bench_spec_free(bench_spec *spec)
+{
+    for(int i = 0; i < spec->count; i++)
+    {
+        free(spec->names[i]);
+        free(spec->keys[i]);
+        free(spec->bundles[i]);
+    }
+
+    cmdf_parser_free(spec->parser);
+    free(spec->names);
+    free(spec->keys);
+    free(spec->bundles);
+    free(spec->cmdf);
+    free(spec->getopt);
+    free(spec->argp);
+    free(spec->short_options);
+    free(spec);
+}
+
+
+// the ways options are written on the command line
+typedef enum
+{
+    BENCH_LONG,                     // "--option-name-4"
+    BENCH_SHORT,                    // "-e"
+    BENCH_BUNDLED                   // "-efgh"
+}bench_style;
+
+
+// a command line of "argc" arguments, counting the program name. Options taking one argument are followed by a value,
+// and an option taking any number of arguments comes once followed by all the others
+static char **bench_argv_make(const bench_spec *spec, int argc, bench_style style)
+{
+    char **argv = malloc(sizeof(*argv) * (argc + 1));
+    int option = 0;
+
+    argv[0] = "bench";
+
+    for(int i = 1; i < argc; i++)
+    {
+        int index = (int)(((long long)option * 7919) % spec->count);
+
+        if(spec->argq == -1 && i > 1)
+            argv[i] = "input-file.txt";
+        else if(spec->argq == 1 && (i % 2) == 0)
+            argv[i] = "value";
+        else
+        {
+            argv[i] = (style == BENCH_SHORT) ? spec->keys[index] : (style == BENCH_BUNDLED) ? spec->bundles[index] : spec->names[index];
+            option++;
+        }
+    }
+
+    argv[argc] = NULL;
+
+    return argv;
+}
+
+
+// what "cdmf_parse_options" does with tables too big to register: compile, parse and free
+static void bench_cmdf_created(const bench_spec *spec, int argc, char **argv)
+{
+    cmdf_parser *parser = cmdf_parser_create(spec->cmdf, PARSER_FLAG_NOT_EXIT_ON_ERROR);
+    size_t sum = 0;
+
+    memset(&parser->registration_result, 0, sizeof(parser->registration_result));
+    cmdf_parser_parse(parser, bench_cmdf_count, argc, argv, &sum);
+    cmdf_parser_free(parser);
+
+    bench_sink += sum;
+}
+
+
+static void bench_cmdf_compiled(const bench_spec *spec, int argc, char **argv)
+{
+    size_t sum = 0;
+
+    cmdf_parser_parse(spec->parser, bench_cmdf_count, argc, argv, &sum);
+    bench_sink += sum;
+}
+
+
+static void bench_cmdf_parse_options(const bench_spec *spec, int argc, char **argv)
+{
+    size_t sum = 0;
+
+    cdmf_parse_options(spec->cmdf, bench_cmdf_count, argc, argv, 0, &sum);
+    bench_sink += sum;
+}
+
+
+static void bench_getopt_long(const bench_spec *spec, int argc, char **argv)
+{
+    size_t sum = 0;
+    int c;
+
+    optind = 0; // full reinitialization
+    opterr = 0;
+
+    while((c = getopt_long(argc, argv, spec->short_options, spec->getopt, NULL)) != -1)
+        sum += c + (optarg != NULL);
+
+    bench_sink += sum;
+}
+
+
+static void bench_argp(const bench_spec *spec, int argc, char **argv)
+{
+    size_t sum = 0;
+
+    argp_parse(&spec->argp_parser, argc, argv, ARGP_IN_ORDER | ARGP_NO_EXIT | ARGP_NO_ERRS, NULL, &sum);
+    bench_sink += sum;
+}
+
+
+static void bench_cmdf_help(const bench_spec *spec, int argc, char **argv)
+{
+    help_write(bench_null, spec->parser, NULL);
+}
+
+
+// "--help=name-7", the options named "option-name-7", "option-name-70" and so on
+static void bench_cmdf_help_filtered(const bench_spec *spec, int argc, char **argv)
+{
+    help_write(bench_null, spec->parser, "name-7");
+}
+
+
+// the options list rendered again on every call, as it was before the help was cached
+static void bench_cmdf_help_render(const bench_spec *spec, int argc, char **argv)
+{
+    size_t length;
+    char *text = help_render(spec->parser, &default_allocator, &length);
+
+    fwrite(text, 1, length, bench_null);
+    free(text);
+}
+
+
+static void bench_argp_help(const bench_spec *spec, int argc, char **argv)
+{
+    argp_help(&spec->argp_parser, bench_null, ARGP_HELP_STD_HELP, "bench");
+}
+
+
+// repeats a run for at least BENCH_MIN_NS, "units" is what the time is divided by for each run
+static bench_measure bench_measure_run(bench_run run, const bench_spec *spec, int argc, char **argv, double units)
+{
+    bench_measure measure;
+    size_t allocations;
+    long resident;
+    double start, elapsed;
+    int repeats = 0;
+
+    peak_memory_reset();
+    resident = status_kib("VmRSS");
+    allocations = bench_allocations;
+    start = now_ns();
+
+    do
+    {
+        run(spec, argc, argv);
+        repeats++;
+        elapsed = now_ns() - start;
+    }while(elapsed < BENCH_MIN_NS);
+
+    measure.ns = elapsed / repeats / units;
+    measure.allocations = (double)(bench_allocations - allocations) / repeats;
+    measure.peak_kib = status_kib("VmHWM") - resident;
+
+    return measure;
+}
+
+
+static void bench_measure_print(const char *label, const char *parser, bench_measure measure)
+{
+    printf("%12s %16s %12.1f %10.1f %10ld\n", label, parser, measure.ns, measure.allocations, measure.peak_kib);
+}
+
+
+static void bench_compare_header(const char *title, const char *label, const char *unit)
+{
+    printf("%s\n", title);
+    printf("%12s %16s %12s %10s %10s\n", label, "parser", unit, "allocs", "peak KiB");
+}
+
+
+// "--name value" pairs with tables too big for the registration rules, compiled on every parse as by "cdmf_parse_options"
+static void bench_tables(void)
+{
+    const int sizes[] = {10, 100, 1000, 10000};
+    const int argc = 20001;
+    char label[32];
+
+    bench_compare_header("option tables, 10000 \"--name value\" pairs", "options", "ns/arg");
+
+    for(size_t s = 0; s < sizeof(sizes)/sizeof(sizes[0]); s++)
+    {
+        bench_spec *spec = bench_spec_make(sizes[s], 1);
+        char **argv = bench_argv_make(spec, argc, BENCH_LONG);
+
+        snprintf(label, sizeof(label), "%d", sizes[s]);
+        bench_measure_print(label, "cmdf", bench_measure_run(bench_cmdf_created, spec, argc, argv, argc - 1));
+        bench_measure_print(label, "cmdf compiled", bench_measure_run(bench_cmdf_compiled, spec, argc, argv, argc - 1));
+        bench_measure_print(label, "getopt_long", bench_measure_run(bench_getopt_long, spec, argc, argv, argc - 1));
+        bench_measure_print(label, "argp", bench_measure_run(bench_argp, spec, argc, argv, argc - 1));
+
+        free(argv);
+        bench_spec_free(spec);
+    }
+
+    printf("\n");
+}
+
+
+// "cdmf_parse_options" from a handful of arguments to a million
+static void bench_argc(void)
+{
+    const int sizes[] = {10, 1000, 100000, 1000000};
+    bench_spec *spec = bench_spec_make(16, 1);
+    char label[32];
+
+    bench_compare_header("command line length, 16 options, \"--name value\" pairs", "arguments", "ns/arg");
+
+    for(size_t s = 0; s < sizeof(sizes)/sizeof(sizes[0]); s++)
+    {
+        int argc = sizes[s] + 1;
+        char **argv = bench_argv_make(spec, argc, BENCH_LONG);
+
+        snprintf(label, sizeof(label), "%d", sizes[s]);
+        bench_measure_print(label, "cmdf", bench_measure_run(bench_cmdf_parse_options, spec, argc, argv, argc - 1));
+        bench_measure_print(label, "getopt_long", bench_measure_run(bench_getopt_long, spec, argc, argv, argc - 1));
+        bench_measure_print(label, "argp", bench_measure_run(bench_argp, spec, argc, argv, argc - 1));
+
+        free(argv);
+    }
+
+    bench_spec_free(spec);
+    printf("\n");
+}
+
+
+// the same flags given as "--name", as "-k" and bundled four to an argument as "-klmn"
+static void bench_keys(void)
+{
+    const char *labels[] = {"long", "short", "bundled"};
+    const int argc = 100001;
+    bench_spec *spec = bench_spec_make(16, 0);
+
+    bench_compare_header("keys, 16 flags, 100000 arguments, bundles of 4 keys", "keys", "ns/arg");
+
+    for(int style = BENCH_LONG; style <= BENCH_BUNDLED; style++)
+    {
+        char **argv = bench_argv_make(spec, argc, (bench_style)style);
+
+        bench_measure_print(labels[style], "cmdf", bench_measure_run(bench_cmdf_parse_options, spec, argc, argv, argc - 1));
+        bench_measure_print(labels[style], "getopt_long", bench_measure_run(bench_getopt_long, spec, argc, argv, argc - 1));
+        bench_measure_print(labels[style], "argp", bench_measure_run(bench_argp, spec, argc, argv, argc - 1));
+
+        free(argv);
+    }
+
+    bench_spec_free(spec);
+    printf("\n");
+}
+
+
+// one option taking any number of arguments, "argq" -1, followed by all of them. getopt_long and argp see them as
+// non options, returned in order
+static void bench_variadic(void)
+{
+    const int sizes[] = {1000, 1000000};
+    bench_spec *spec = bench_spec_make(1, -1);
+    char label[32];
+
+    bench_compare_header("argq -1, one option followed by every argument", "arguments", "ns/arg");
+
+    for(size_t s = 0; s < sizeof(sizes)/sizeof(sizes[0]); s++)
+    {
+        int argc = sizes[s] + 1;
+        char **argv = bench_argv_make(spec, argc, BENCH_LONG);
+
+        snprintf(label, sizeof(label), "%d", sizes[s]);
+        bench_measure_print(label, "cmdf", bench_measure_run(bench_cmdf_parse_options, spec, argc, argv, argc - 1));
+        bench_measure_print(label, "getopt_long", bench_measure_run(bench_getopt_long, spec, argc, argv, argc - 1));
+        bench_measure_print(label, "argp", bench_measure_run(bench_argp, spec, argc, argv, argc - 1));
+
+        free(argv);
+    }
+
+    bench_spec_free(spec);
+    printf("\n");
+}
+
+
+// the options list of --help, written to /dev/null
+static void bench_help(void)
+{
+    const int sizes[] = {10, 100, 1000, 10000};
+    char label[32];
+
+    bench_compare_header("help text", "options", "ns/help");
+
+    for(size_t s = 0; s < sizeof(sizes)/sizeof(sizes[0]); s++)
+    {
+        bench_spec *spec = bench_spec_make(sizes[s], 1);
+
+        snprintf(label, sizeof(label), "%d", sizes[s]);
+        bench_measure_print(label, "cmdf", bench_measure_run(bench_cmdf_help, spec, 0, NULL, 1));
+        bench_measure_print(label, "cmdf filtered", bench_measure_run(bench_cmdf_help_filtered, spec, 0, NULL, 1));
+        bench_measure_print(label, "cmdf render", bench_measure_run(bench_cmdf_help_render, spec, 0, NULL, 1));
+        bench_measure_print(label, "argp", bench_measure_run(bench_argp_help, spec, 0, NULL, 1));
+
+        bench_spec_free(spec);
+    }
+
+    printf("\n");
+}
+
+
+/* Main ----------------------------------------------------------------------------------- */
+
+
+static const struct
+{
+    const char *name;
+    void (*run)(void);
+}bench_sections[] =
+{
+    {"lookup",      bench_long_name_lookup},
+    {"response",    bench_response_file},
+    {"stream",      bench_stream},
+    {"tokenizer",   bench_tokenizer},
+    {"bindings",    bench_bindings},
+    {"suggest",     bench_suggest},
+    {"commands",    bench_commands},
+    {"complete",    bench_complete},
+    {"config",      bench_config},
+    {"spans",       bench_spans},
+    {"constraints", bench_constraints},
+    {"wide",        bench_wide},
+    {"arena",       bench_arena},
+    {"tables",      bench_tables},
+    {"argc",        bench_argc},
+    {"keys",        bench_keys},
+    {"variadic",    bench_variadic},
+    {"help",        bench_help},
+};
+
+
+// runs the sections named on the command line, or all of them
+int main(int argc, char **argv)
+{
+    bench_null = fopen("/dev/null", "w");
+
+    printf("gcc %s, glibc %s\n\n", __VERSION__, gnu_get_libc_version());
+
+    for(size_t s = 0; s < sizeof(bench_sections)/sizeof(bench_sections[0]); s++)
+    {
+        int selected = (argc < 2);
+
+        for(int i = 1; i < argc; i++)
+            selected |= !strcmp(argv[i], bench_sections[s].name);
+
+        if(selected)
+            bench_sections[s].run();
+    }
+
+    fclose(bench_null);
+
+    return (bench_failures > 0);
+}
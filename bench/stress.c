@@ -0,0 +1,129 @@
+/**
+ * Thread stress driver for the library CMD Friend, built with ThreadSanitizer.
+ *
+ * A single parser is shared by the 8 threads of a batch parse, with a mix of good command lines, unknown options, whose
+ * suggestions come from the index built on first use, ambiguous abbreviations and "--help=" filters, which write the
+ * cached help text. A new parser is made for every round, so the threads race to build its caches. The same rounds then
+ * run on the parser generated from "bench/stress_spec.h", whose caches don't come from a parser allocator.
+ *
+ * Build and run with "make tsan", ThreadSanitizer then reports any data race and the run exits with an error.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "cmdf.h"
+#include "stress_parser.h"
+
+
+#define STRESS_THREADS 8
+#define STRESS_ROUNDS 20
+#define STRESS_LINES 512
+
+
+// counts of a single command line, every line has its own
+typedef struct
+{
+    int verbose;
+    int files;
+}stress_counts;
+
+
+static int stress_parse(char key, char *arg, int arg_pos, void *user)
+{
+    stress_counts *counts = (stress_counts*)user;
+
+    if(key == 'v')
+        counts->verbose++;
+    else if(key == 'f')
+        counts->files += (arg != NULL);
+
+    return 0;
+}
+
+
+static char *stress_valid[] = {"stress", "-v", "--output", "out.txt", "--files", "a.txt", "b.txt"};
+static char *stress_unknown[] = {"stress", "--outptu", "out.txt", "--verbsoe"};
+static char *stress_ambiguous[] = {"stress", "--option"};
+static char *stress_help[] = {"stress", "--help=option"};
+
+
+// parses the lines of a round with the batch threads, returns the number of lines with an unexpected outcome
+static int stress_round(const cmdf_parser *parser)
+{
+    static cmdf_batch_item items[STRESS_LINES];
+    static stress_counts counts[STRESS_LINES];
+    int failures = 0;
+    int errors;
+
+    for(int i = 0; i < STRESS_LINES; i++)
+    {
+        memset(&(counts[i]), 0, sizeof(counts[i]));
+        items[i].extern_user_variables_struct = &(counts[i]);
+
+        switch(i % 4)
+        {
+            case 0: items[i].argc = 7; items[i].argv = stress_valid; break;
+            case 1: items[i].argc = 4; items[i].argv = stress_unknown; break;
+            case 2: items[i].argc = 2; items[i].argv = stress_ambiguous; break;
+            default: items[i].argc = 2; items[i].argv = stress_help; break;
+        }
+    }
+
+    errors = cmdf_parser_parse_batch(parser, stress_parse, items, STRESS_LINES, STRESS_THREADS);
+
+    // every line but the good ones and "--help=" has an error, and the good ones give each option once
+    for(int i = 0; i < STRESS_LINES; i++)
+    {
+        int error_expected = (i % 4 == 1 || i % 4 == 2);
+
+        failures += ((items[i].error != 0) != error_expected);
+        failures += (i % 4 == 0 && (counts[i].verbose != 1 || counts[i].files != 2));
+    }
+
+    return failures + (errors != STRESS_LINES / 2);
+}
+
+
+int main(void)
+{
+    cmdf_option options[] =
+    {
+        {"verbose",      'v', OPTION_OPTIONAL, 0,  "Verbose mode"},
+        {"output",       'o', OPTION_OPTIONAL, 1,  "Output file"},
+        {"option-alpha", 'a', OPTION_OPTIONAL, 0,  "First option"},
+        {"option-beta",  'b', OPTION_OPTIONAL, 0,  "Second option"},
+        {"files",        'f', OPTION_OPTIONAL, -1, "Input files"},
+        {0}
+    };
+    FILE *null = fopen("/dev/null", "w");
+    int failures = 0;
+
+    if(null == NULL)
+        return 1;
+
+    for(int round = 0; round < STRESS_ROUNDS; round++)
+    {
+        cmdf_parser *parser = cmdf_parser_create(options, PARSER_FLAG_NOT_EXIT_ON_ERROR | PARSER_FLAG_USE_PREDEFINED_OPTIONS |
+                                                 PARSER_FLAG_DONT_IGNORE_NON_REGISTERED_OPTIONS | PARSER_FLAG_ALLOW_ABBREVIATIONS);
+
+        if(parser == NULL)
+            return 1;
+
+        cmdf_parser_set_output(parser, null);
+        failures += stress_round(parser);
+        cmdf_parser_free(parser);
+    }
+
+    cmdf_parser_set_output(stress_generated, null);
+
+    for(int round = 0; round < STRESS_ROUNDS; round++)
+        failures += stress_round(stress_generated);
+
+    fclose(null);
+
+    printf("stress, %d rounds of %d command lines on %d threads, runtime and generated parsers: %s\n", STRESS_ROUNDS, STRESS_LINES, STRESS_THREADS, (failures == 0) ? "ok" : "FAILED");
+
+    return (failures > 0);
+}
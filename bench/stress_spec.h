@@ -0,0 +1,12 @@
+/**
+ * Options spec of the generated parser of "bench/stress.c", the options of its runtime parser.
+ */
+
+#define CMDF_SPEC_NAME stress_generated
+#define CMDF_SPEC_FLAGS (PARSER_FLAG_NOT_EXIT_ON_ERROR | PARSER_FLAG_USE_PREDEFINED_OPTIONS | PARSER_FLAG_DONT_IGNORE_NON_REGISTERED_OPTIONS | PARSER_FLAG_ALLOW_ABBREVIATIONS)
+#define CMDF_SPEC_OPTIONS(X) \
+    X("verbose",      'v', OPTION_OPTIONAL, 0,  "Verbose mode") \
+    X("output",       'o', OPTION_OPTIONAL, 1,  "Output file") \
+    X("option-alpha", 'a', OPTION_OPTIONAL, 0,  "First option") \
+    X("option-beta",  'b', OPTION_OPTIONAL, 0,  "Second option") \
+    X("files",        'f', OPTION_OPTIONAL, -1, "Input files")
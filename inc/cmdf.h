@@ -154,6 +154,8 @@ extern "C" {
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 
 
@@ -164,7 +166,34 @@ extern "C" {
 #define __VERSION_KEY    124     // default version option key
 #define __HELP_KEY       125     // default help option key, in case of the 'h' key be desired i suggest using 125 as a key instead
 
-#define MAX_CMD_ARGUMENTS 1000 // maximum number of arguments to be parsed
+#define CMDF_COMPLETE_OPTION        "--__complete"          // first argument of a completion query: "prog --__complete <cursor> <words...>"
+#define CMDF_COMPLETE_SCRIPT_OPTION "--__complete-script"   // first argument asking for the shell glue: "prog --__complete-script bash|zsh|fish"
+
+#define CMDF_MAX_ERRORS  16      // maximum number of errors kept on a cmdf_result, the count goes on after that
+
+#define CMDF_WIDE_ID_BASE   0x100                                       // first automatic id, above every char key
+#define CMDF_AUTO_ID(index) ((int32_t)(CMDF_WIDE_ID_BASE + (index)))    // id given with PARSER_FLAG_WIDE_KEYS to the option at "index" of the options array when it has no char key nor id
+
+#ifndef CMDF_STREAM_BUFFER_LENGTH
+#define CMDF_STREAM_BUFFER_LENGTH 4096 // bytes of the stack buffer of "cmdf_parser_parse_fd", the longest streamed argument is one less, see "cmdf_parser_parse_fd_buffer"
+#endif
+
+// #define CMDF_ENABLE_STATS    // define when compiling the library to record the "cmdf_stats" of every parse, without it no statistics code is compiled
+
+#define MAX_CMD_ARGUMENTS 1000 // no longer enforced, any number of arguments can be parsed. Kept for source compatibility
+
+// bindings of an option to a member of the user struct, for the "binding" field of "cmdf_option", see "BINDINGS_Typedef"
+// min and max limit the value, both 0 for the whole range of the member type
+#define CMDF_MEMBER_SIZE(type, member)              sizeof(((type*)0)->member)
+#define CMDF_BIND_FLAG(type, member)                {BINDING_SET_TRUE, offsetof(type, member), CMDF_MEMBER_SIZE(type, member), 0, 0, NULL}
+#define CMDF_BIND_COUNT(type, member)               {BINDING_COUNT, offsetof(type, member), CMDF_MEMBER_SIZE(type, member), 0, 0, NULL}
+#define CMDF_BIND_STRING(type, member)              {BINDING_STRING, offsetof(type, member), CMDF_MEMBER_SIZE(type, member), 0, 0, NULL}
+#define CMDF_BIND_INT(type, member, min, max)       {BINDING_INT, offsetof(type, member), CMDF_MEMBER_SIZE(type, member), min, max, NULL}
+#define CMDF_BIND_UINT(type, member, min, max)      {BINDING_UINT, offsetof(type, member), CMDF_MEMBER_SIZE(type, member), min, max, NULL}
+#define CMDF_BIND_FLOAT(type, member)               {BINDING_FLOAT, offsetof(type, member), CMDF_MEMBER_SIZE(type, member), 0, 0, NULL}
+#define CMDF_BIND_SIZE(type, member, min, max)      {BINDING_SIZE, offsetof(type, member), CMDF_MEMBER_SIZE(type, member), min, max, NULL}
+#define CMDF_BIND_ENUM(type, member, names)         {BINDING_ENUM, offsetof(type, member), CMDF_MEMBER_SIZE(type, member), 0, 0, names}
+#define CMDF_BIND_APPEND(type, member)              {BINDING_APPEND, offsetof(type, member), CMDF_MEMBER_SIZE(type, member), 0, 0, NULL}
 
 
 /* -------------------------------------------- Enumerators ---------------------------------------------------- */
@@ -185,6 +214,42 @@ typedef enum
 }OPTIONS_Typedef;
 
 
+/**
+ * @brief What an option bound to a member of the user struct does with it, instead of calling the parse function.
+ * 
+ * Numbers are read without the C locale, in decimal or in hexadecimal after "0x", and must fit the member and its range.
+ */
+typedef enum
+{
+    BINDING_NONE = 0,       /**< No binding, the option calls the parse function */
+    BINDING_SET_TRUE,       /**< Sets an integer member to 1, for options with argq 0 */
+    BINDING_COUNT,          /**< Adds one to an integer member every time the option is given, for options with argq 0 */
+    BINDING_STRING,         /**< Stores the argument on a "char *" member, pointing into argv */
+    BINDING_INT,            /**< Converts the argument to a signed integer member of 1, 2, 4 or 8 bytes */
+    BINDING_UINT,           /**< Converts the argument to an unsigned integer member of 1, 2, 4 or 8 bytes */
+    BINDING_FLOAT,          /**< Converts the argument to a float or double member, '.' is always the decimal point */
+    BINDING_SIZE,           /**< Converts a size with an optional suffix, k, M, G or T for powers of 1024, to an unsigned integer member */
+    BINDING_ENUM,           /**< Stores on an integer member the index of the argument in the NULL ended "names" list */
+    BINDING_APPEND          /**< Appends every argument to a "cmdf_list" member */
+}BINDINGS_Typedef;
+
+
+/**
+ * @brief Kinds of constraints between options, see "cmdf_parser_set_constraints".
+ * 
+ * An option and its aliases count as a single option.
+ */
+typedef enum
+{
+    CONSTRAINT_NONE = 0,    /**< Ends the constraints array */
+    CONSTRAINT_EXCLUSIVE,   /**< At most one of the options can be given */
+    CONSTRAINT_AT_LEAST_ONE,/**< At least one of the options must be given */
+    CONSTRAINT_EXACTLY_ONE, /**< One of the options, and only one, must be given */
+    CONSTRAINT_REQUIRES,    /**< The first option can only be given with every other option */
+    CONSTRAINT_CONFLICTS    /**< The first option can't be given with any other option */
+}CONSTRAINTS_Typedef;
+
+
 /**
  * @brief Flags for when calling cmdf_parse_options.
  * 
@@ -192,14 +257,50 @@ typedef enum
  */
 typedef enum
 {
-    //PARSER_FLAG_NOT_EXIT_ON_ERROR                   = 0x01,     /**< When an exception occurs don't exit program */
+    PARSER_FLAG_NOT_EXIT_ON_ERROR                   = 0x01,     /**< When an exception occurs don't exit program, errors are returned and only printed if a print flag is set */
     PARSER_FLAG_PRINT_ERRORS_STDOUT                 = 0x02,     /**< Print error messages to stdout */
     PARSER_FLAG_PRINT_ERRORS_STDERR                 = 0x04,     /**< Print error messages to stderr */
     PARSER_FLAG_DONT_IGNORE_NON_REGISTERED_OPTIONS  = 0x08,     /**< Extra options given by the user do not are discarted, an error will be trown */
-    PARSER_FLAG_USE_PREDEFINED_OPTIONS              = 0x10      /**< Create automatic options, by default: --help (-h), --info (-i), --version (-v) */
+    PARSER_FLAG_USE_PREDEFINED_OPTIONS              = 0x10,     /**< Create automatic options, by default: --help (-h), --info (-i), --version (-v) */
+    PARSER_FLAG_EXPAND_RESPONSE_FILES               = 0x20,     /**< Arguments "@path" are replaced by the arguments written in the file "path", see "cmdf_args_expand". Used by "cdmf_parse_options" */
+    PARSER_FLAG_ALLOW_ABBREVIATIONS                 = 0x40,     /**< A long name can be shortened to any prefix that only one option starts with, "--verb" for "--verbose" */
+    PARSER_FLAG_ENABLE_COMPLETION                   = 0x80,     /**< Answer the shell completion queries "--__complete" and "--__complete-script", see "cmdf_parser_complete" */
+    PARSER_FLAG_WIDE_KEYS                           = 0x100     /**< Options with (OPTION_NO_CHAR_KEY) need no unique key, they are told apart by their "id" and only given to "cmdf_parser_parse_wide" */
 }PARSER_FLAGS_Typedef;
 
 
+/**
+ * @brief Error codes reported by the parser.
+ * 
+ * Returned by the parse functions and recorded on "cmdf_result" when the flag PARSER_FLAG_NOT_EXIT_ON_ERROR is set.
+ */
+typedef enum
+{
+    PARSER_ERROR_NONE = 0,                          /**< No error occurred */
+    PARSER_ERROR_INVALID_OPTION,                    /**< An option that is not registered was given, only with PARSER_FLAG_DONT_IGNORE_NON_REGISTERED_OPTIONS */
+    PARSER_ERROR_NESTED_OPTION,                     /**< An option that takes arguments was nested with others in a single "-" */
+    PARSER_ERROR_MISSING_ARGUMENTS,                 /**< An option that takes any quantity of arguments received none */
+    PARSER_ERROR_TOO_FEW_ARGUMENTS,                 /**< An option received less arguments than it takes */
+    PARSER_ERROR_TOO_MANY_ARGUMENTS,                /**< An option received more arguments than it takes */
+    PARSER_ERROR_REQUIRED_OPTION,                   /**< An option without (OPTION_OPTIONAL) was not given */
+    PARSER_ERROR_DUPLICATED_KEY,                    /**< Registration error, two options use the same key, or the same id with PARSER_FLAG_WIDE_KEYS */
+    PARSER_ERROR_INVALID_KEY,                       /**< Registration error, the key is 0 or doesn't agree with (OPTION_NO_CHAR_KEY), or the id is negative */
+    PARSER_ERROR_INVALID_ARGQ,                      /**< Registration error, the number of arguments is less than -1 */
+    PARSER_ERROR_ALIAS_WITHOUT_OPTION,              /**< Registration error, an alias was declared without an option above it */
+    PARSER_ERROR_OUT_OF_MEMORY,                     /**< The allocator had no memory for the parser tables */
+    PARSER_ERROR_RESPONSE_FILE,                     /**< A response file could not be read, or they were nested too deep */
+    PARSER_ERROR_STREAM_READ,                       /**< Reading the arguments stream failed */
+    PARSER_ERROR_ARGUMENT_TOO_LONG,                 /**< An argument of the stream doesn't fit in the stream buffer, it is skipped */
+    PARSER_ERROR_INVALID_VALUE,                     /**< An argument could not be converted to the type of the value it is bound to, or is out of its range */
+    PARSER_ERROR_INVALID_BINDING,                   /**< Registration error, the binding doesn't agree with the number of arguments or with the member size */
+    PARSER_ERROR_AMBIGUOUS_OPTION,                  /**< An abbreviated long name is the start of more than one option, only with PARSER_FLAG_ALLOW_ABBREVIATIONS */
+    PARSER_ERROR_CONFIG_FILE,                       /**< The config file could not be read, see "cmdf_parser_set_config_file" */
+    PARSER_ERROR_CONSTRAINT,                        /**< The options given break a constraint of "cmdf_parser_set_constraints" */
+    PARSER_ERROR_INVALID_CONSTRAINT,                /**< A constraint names an option that is not registered, or names too few options */
+    PARSER_ERROR_WIDE_KEYS                          /**< A parser with PARSER_FLAG_WIDE_KEYS was given a parse, view or span function, which receive char keys */
+}PARSER_ERRORS_Typedef;
+
+
 /* -------------------------------------------- Structures and typedefs----------------------------------------- */
 
 
@@ -215,6 +316,86 @@ typedef enum
 typedef int (*option_parse_function)(char key, char *arg, int arg_pos, void *extern_user_variables_struct);
 
 
+/**
+ * @brief Argument given as a pointer and a length, so the view functions don't measure it again.
+ * 
+ * The chars are those of the command line, never copied nor changed, the value of "--name=value" points right after the '='.
+ * The chars are still followed by a zero, as every argument ends where its argv string ends.
+ */
+typedef struct
+{
+    const char *data;                               /**< First char of the argument, NULL for options without arguments */
+    size_t length;                                  /**< Number of chars of the argument */
+}cmdf_view;
+
+
+/**
+ * @brief Typedef from user view function, the variant of "option_parse_function" given to "cmdf_parser_parse_views".
+ * @param key: Receives the char key of the option, 0 for floating arguments.
+ * @param arg: Receives the argument passed to that option as a view, {NULL, 0} for options without arguments.
+ * @param arg_pos: The command line argument index where the user inserted the argumment.
+ * @param extern_user_variables_struct: Opaque pointer to user define struct in main program.
+ */
+typedef int (*option_view_function)(char key, cmdf_view arg, int arg_pos, void *extern_user_variables_struct);
+
+
+/**
+ * @brief Typedef from user span function, receiving a whole run of arguments of an option in a single call, see "cmdf_parser_set_span_function".
+ * @param key: Receives the char key of the option.
+ * @param args: Receives the arguments, "count" strings next to each other, a part of argv when parsing an argv.
+ * @param count: Number of arguments in "args".
+ * @param extern_user_variables_struct: Opaque pointer to user define struct in main program.
+ */
+typedef int (*option_span_function)(char key, char **args, int count, void *extern_user_variables_struct);
+
+
+/**
+ * @brief Typedef from user wide parse function, the variant of "option_parse_function" given to "cmdf_parser_parse_wide".
+ * @param id: Receives the id of the option, see "id" of "cmdf_option", 0 for floating arguments.
+ * @param arg: Receives the argument passed to that option, NULL for options without arguments.
+ * @param arg_pos: The command line argument index where the user inserted the argumment.
+ * @param extern_user_variables_struct: Opaque pointer to user define struct in main program.
+ */
+typedef int (*option_wide_function)(int32_t id, char *arg, int arg_pos, void *extern_user_variables_struct);
+
+
+/**
+ * @brief Binding of an option to a member of the user struct, made with the "CMDF_BIND_*" macros.
+ * 
+ * The option then writes its arguments straight into the struct given to the parse, the parse function is not called for it.
+ */
+typedef struct
+{
+    BINDINGS_Typedef action;                        /**< What the option does with the member */
+    size_t offset;                                  /**< Offset of the member in the user struct, from "offsetof" */
+    size_t size;                                    /**< Size of the member */
+    long long min;                                  /**< Minimum value of number members, min and max 0 for the whole range of the member type */
+    long long max;                                  /**< Maximum value of number members */
+    const char *const *names;                       /**< For BINDING_ENUM, names of the values, ended by NULL */
+}cmdf_binding;
+
+
+/**
+ * @brief A constraint between options, an array of them ended by an empty one is given to "cmdf_parser_set_constraints".
+ */
+typedef struct
+{
+    CONSTRAINTS_Typedef kind;                       /**< What is checked */
+    const char *options;                            /**< Long names of the options separated by spaces, as "json xml yaml". For CONSTRAINT_REQUIRES and CONSTRAINT_CONFLICTS the first one requires or conflicts with the others */
+}cmdf_constraint;
+
+
+/**
+ * @brief List member for BINDING_APPEND, the program gives the storage and the arguments are appended to it.
+ */
+typedef struct
+{
+    char **items;                                   /**< Storage for the arguments, given by the program */
+    int len;                                        /**< Number of arguments appended */
+    int capacity;                                   /**< Number of arguments that fit in "items" */
+}cmdf_list;
+
+
 /**
  * @brief defines a single option in command line.
  * 
@@ -230,14 +411,157 @@ typedef struct
     OPTIONS_Typedef parameters;                     /**< Parameters to enhance functionality */
     int argq;                                       /**< The number of arguments that this option takes, can be >0, if 0 then expects none, if -1 accepts any quantity but at least one */
     char *description;                              /**< Small description of the option*/
+    cmdf_binding binding;                           /**< Optional, writes the arguments straight into the user struct, see "CMDF_BIND_*". Unused when left out */
+    const char *env_name;                           /**< Optional, environment variable giving the option when it is not on the command line, see "cmdf_parser_set_config_file". NULL for none */
+    int32_t id;                                     /**< Optional, id given to "option_wide_function", above 0. When left 0 it is the char key, or with PARSER_FLAG_WIDE_KEYS "CMDF_AUTO_ID" of the index of an option with (OPTION_NO_CHAR_KEY), and the id of the above option for an alias */
 }cmdf_option;
 
 
+/**
+ * @brief Memory allocator used by a parser for all its memory.
+ * 
+ * Every function receives the "context" pointer, for allocators that need their own state.
+ */
+typedef struct
+{
+    void *(*alloc)(size_t size, void *context);                                         /**< Returns a block of at least "size" bytes, aligned for any type, or NULL */
+    void *(*realloc)(void *pointer, size_t old_size, size_t new_size, void *context);   /**< Resizes a block keeping its content, just as the C library realloc, or returns NULL */
+    void (*free)(void *pointer, void *context);                                         /**< Releases a block, never called with NULL */
+    void *context;                                  /**< User pointer given to the functions */
+}cmdf_allocator;
+
+
+/**
+ * @brief Bump allocator over a user buffer, see "cmdf_arena_allocator".
+ * 
+ * Blocks are taken in sequence from the buffer and are only released all at once with "cmdf_arena_reset".
+ * After creating a parser "used" tells how much of the buffer it took, which can be used to size the buffer.
+ */
+typedef struct
+{
+    unsigned char *buffer;                          /**< Buffer the blocks are taken from */
+    size_t size;                                    /**< Size of the buffer */
+    size_t used;                                    /**< Bytes of the buffer already taken */
+    size_t last;                                    /**< Offset of the last block taken, which can grow in place */
+}cmdf_arena;
+
+
+/**
+ * @brief Command line with its response files expanded, made by "cmdf_args_expand", or split from a string by "cmdf_args_tokenize".
+ * 
+ * The arguments read from response files point into the files themselves, loaded in memory, so they stay valid until "cmdf_args_free".
+ */
+typedef struct
+{
+    int argc;                                       /**< Number of arguments after the expansion */
+    char **argv;                                    /**< Arguments after the expansion, ended by NULL just as the main argv */
+    const char *error_path;                         /**< When the expansion fails, the path of the response file that could not be read */
+    cmdf_allocator allocator;                       /**< Private, allocator of argv and of the loaded files bookkeeping */
+    int argv_capacity;                              /**< Private, room in argv */
+    void *mappings;                                 /**< Private, response files loaded in memory */
+    int mappings_len;                               /**< Private, number of loaded response files */
+    int mappings_capacity;                          /**< Private, room for loaded response files */
+}cmdf_args;
+
+
+/**
+ * @brief A single error found by the parser.
+ */
+typedef struct
+{
+    PARSER_ERRORS_Typedef code;                     /**< What went wrong */
+    int arg_index;                                  /**< Index on argv of the offending argument, -1 for errors not tied to an argument, like registration errors and missing required options */
+    const cmdf_option *option;                      /**< The offending option, owned by the parser, NULL for options that are not registered */
+}cmdf_error;
+
+
+/**
+ * @brief Errors found on a single parse.
+ * 
+ * With the flag PARSER_FLAG_NOT_EXIT_ON_ERROR the parser doesn't stop on the first error, every error is recorded here in the order they were found.
+ */
+typedef struct
+{
+    int error_count;                                /**< Number of errors found, can be bigger than CMDF_MAX_ERRORS */
+    cmdf_error errors[CMDF_MAX_ERRORS];             /**< The first CMDF_MAX_ERRORS errors found */
+}cmdf_result;
+
+
+/**
+ * @brief Compiled parser, made from an options array by "cmdf_parser_create".
+ * 
+ * Holds the merged options array and every lookup table needed to parse, so all the registration checks run only once
+ * and any number of command lines can be parsed afterwards without setup or allocations.
+ * The content is private to the library, use the cmdf_parser_ functions.
+ */
+typedef struct cmdf_parser cmdf_parser;
+
+
+/**
+ * @brief A single command line of a batch parse, see "cmdf_parser_parse_batch".
+ */
+typedef struct
+{
+    int argc;                                       /**< Number of arguments in argv */
+    char **argv;                                    /**< Arguments of the command line, the first one is taken as the program name and skipped */
+    void *extern_user_variables_struct;             /**< Opaque pointer passed to the user parse function for this command line */
+    int error;                                      /**< Receives the code of the first error found, 0 if no error occurred */
+    cmdf_result result;                             /**< Receives every error found */
+}cmdf_batch_item;
+
+
+/**
+ * @brief A command of a git-style program, as "tool commit -m text", with its own options and subcommands.
+ *
+ * The options of a command are also taken by all of its subcommands, after their own, so "tool --verbose commit" and
+ * "tool commit --verbose" are the same. Each command is only compiled to a parser when a command line selects it,
+ * see "cmdf_command_tree_parse".
+ */
+typedef struct cmdf_command
+{
+    const char *name;                               /**< Name of the command on the command line, NULL ends a list of commands. Not used for the root */
+    cmdf_option *options;                           /**< Options of the command, ended by an empty option, NULL for none */
+    option_parse_function parse_function;           /**< Parse function of the options of the command, its own and the inherited ones. NULL for the one of the command above */
+    const char *description;                        /**< Description shown in the commands list of --help of the command above */
+    const char *usage;                              /**< Usage info printed by --help of the command, NULL for the one of the command above */
+    struct cmdf_command *commands;                  /**< Subcommands, ended by a command with a NULL name, NULL for none */
+}cmdf_command;
+
+
+/**
+ * @brief Tree of commands with the parsers of the commands already selected by a command line, made by "cmdf_command_tree_create".
+ * The content is private to the library, use the cmdf_command_tree_ functions.
+ */
+typedef struct cmdf_command_tree cmdf_command_tree;
+
+
+/**
+ * @brief Statistics of a single parse, see "cmdf_stats_get". Only recorded when the library is compiled with CMDF_ENABLE_STATS.
+ *
+ * The preparation of the tables happens once, when the parser is created, and is reported again by every parse made with it.
+ * Times are in nanoseconds.
+ */
+typedef struct
+{
+    unsigned long long prepare_ns;                  /**< Time spent by the parser creation checking the options and building the lookup tables */
+    unsigned long long parse_ns;                    /**< Time of the whole parse, the callbacks included */
+    unsigned long long key_lookups;                 /**< Options looked up by char key, each one a single table read */
+    unsigned long long long_name_lookups;           /**< Options looked up by long name */
+    unsigned long long long_name_probes;            /**< Slots of the long name index visited by those lookups */
+    unsigned long long long_name_comparisons;       /**< Long names compared by those lookups, only for slots whose hash and length matched */
+    unsigned long long allocations;                 /**< Blocks taken from the allocator, by the parser creation and by the parse */
+    unsigned long long allocated_bytes;             /**< Bytes of those blocks */
+    unsigned long long callbacks;                   /**< Calls to the user parse function, and to the view and span functions */
+    unsigned long long callback_ns;                 /**< Time spent inside the user parse function */
+}cmdf_stats;
+
+
 /* -------------------------------------------- Public prototypes ---------------------------------------------- */
 
 
 /**
  * @brief Set default value of cmdf_default_info_usage.
+ * Parsers copy the value when created, use "cmdf_parser_set_info_usage" to change a single parser.
  * @param info_string: Const string with desired information.
  */
 void set_cmdf_default_info_usage(const char *info_string);
@@ -245,6 +569,7 @@ void set_cmdf_default_info_usage(const char *info_string);
 
 /**
  * @brief Set default value of cmdf_default_info_version.
+ * Parsers copy the value when created, use "cmdf_parser_set_info_version" to change a single parser.
  * @param info_string: Const string with desired information.
  */
 void set_cmdf_default_info_version(const char *info_string);
@@ -252,6 +577,7 @@ void set_cmdf_default_info_version(const char *info_string);
 
 /**
  * @brief Set default value of cmdf_default_info_contact.
+ * Parsers copy the value when created, use "cmdf_parser_set_info_contact_info" to change a single parser.
  * @param info_string: Const string with desired information.
  */
 void set_cmdf_default_info_contact_info(const char *info_string);
@@ -262,16 +588,422 @@ void set_cmdf_default_info_contact_info(const char *info_string);
  * The "cdmf_parse_options" function will call the user defined function to handle actions as desired.
  * Each call will have a key and argument, where each argument must have be assigned to only one key.
  * @param registered_options: Receives pointer to struct "cmdf_option" array that shall contain user define options.
- * @param parse_function: User defined parse function pointer.
+ * @param parse_function: User defined parse function pointer, may be NULL when every option is bound to a member and floating arguments are not needed.
  * @param argc: Main function parameter containing number of passed parameters in command line.
  * @param argv: Main function parameter containing the array of string containing the actual parameters.
  * @param flags: Flags used to customize the function "cdmf_parse_options" behavior, flags shall be located on "PARSER_FLAGS_Typedef" enumerator.
+ *        With PARSER_FLAG_EXPAND_RESPONSE_FILES the response files are expanded and kept loaded until the program ends, just as argv.
  * @param extern_user_variables_struct: Opaque pointer to user define struct in main program, used to be accessed in the also user define parser function.
- * @return Returns a integer number correponding to a error code, 0 if no error occurred. Note: NO ERROR CODE IMPLEMENTED AT THIS VERSION.
+ * @return Returns the code of the first error found, see "PARSER_ERRORS_Typedef", 0 if no error occurred. Only returns on errors with the flag PARSER_FLAG_NOT_EXIT_ON_ERROR.
  */
 int cdmf_parse_options(cmdf_option *registered_options, option_parse_function parse_function, int argc, char **argv, PARSER_FLAGS_Typedef flags, void *extern_user_variables_struct);
 
 
+/**
+ * @brief Compiles a parser for an options array, checking the options and building the lookup tables only once.
+ * The parser keeps pointers to the names and descriptions of the options, so they must live as long as the parser.
+ * With the flag PARSER_FLAG_NOT_EXIT_ON_ERROR a parser is returned even if the options have errors, every parse will then report them without parsing.
+ * @param registered_options: Receives pointer to struct "cmdf_option" array that shall contain user define options.
+ * @param flags: Flags used to customize the parser behavior, flags shall be located on "PARSER_FLAGS_Typedef" enumerator.
+ * @return Returns the compiled parser, to be released with "cmdf_parser_free", or NULL if there is no memory.
+ */
+cmdf_parser *cmdf_parser_create(cmdf_option *registered_options, PARSER_FLAGS_Typedef flags);
+
+
+/**
+ * @brief Compiles a parser just as "cmdf_parser_create", taking the parser and all its tables from an allocator.
+ * 
+ * Zero allocation mode: with an arena allocator over a static or stack buffer, creating a parser and parsing any
+ * number of command lines with "cmdf_parser_parse" or "cmdf_parser_parse_result" never calls malloc.
+ * The batch parse still needs the threads from the system.
+ * 
+ * @param registered_options: Receives pointer to struct "cmdf_option" array that shall contain user define options.
+ * @param flags: Flags used to customize the parser behavior, flags shall be located on "PARSER_FLAGS_Typedef" enumerator.
+ * @param allocator: Allocator to be used, copied into the parser. NULL uses the C library malloc.
+ * @return Returns the compiled parser, to be released with "cmdf_parser_free", or NULL if the allocator had no memory.
+ */
+cmdf_parser *cmdf_parser_create_with_allocator(cmdf_option *registered_options, PARSER_FLAGS_Typedef flags, const cmdf_allocator *allocator);
+
+
+/**
+ * @brief Prepares an arena over a user buffer.
+ * @param arena: Arena to be prepared.
+ * @param buffer: Buffer the arena gives its blocks from, must live as long as anything allocated from it.
+ * @param size: Size of the buffer in bytes.
+ */
+void cmdf_arena_init(cmdf_arena *arena, void *buffer, size_t size);
+
+
+/**
+ * @brief Releases every block taken from an arena at once, anything allocated from it can't be used anymore.
+ * @param arena: Arena prepared by "cmdf_arena_init".
+ */
+void cmdf_arena_reset(cmdf_arena *arena);
+
+
+/**
+ * @brief Makes an allocator that takes its blocks from an arena. Releasing a block does nothing, use "cmdf_arena_reset".
+ * @param arena: Arena prepared by "cmdf_arena_init", must live as long as the allocator is used.
+ * @return Returns the allocator, to be given to "cmdf_parser_create_with_allocator".
+ */
+cmdf_allocator cmdf_arena_allocator(cmdf_arena *arena);
+
+
+/**
+ * @brief Parses a command line with a compiled parser, just as "cdmf_parse_options" does but without preparing the options again.
+ * Can be called any number of times with different command lines, no memory is allocated.
+ * The parser is not changed, so many threads can parse with the same parser at the same time.
+ * @param parser: Parser made by "cmdf_parser_create".
+ * @param parse_function: User defined parse function pointer, may be NULL when every option is bound to a member and floating arguments are not needed.
+ * @param argc: Number of arguments in argv.
+ * @param argv: Array of strings containing the arguments, the first one is taken as the program name and skipped.
+ * @param extern_user_variables_struct: Opaque pointer to user define struct in main program, used to be accessed in the also user define parser function.
+ * @return Returns the code of the first error found, see "PARSER_ERRORS_Typedef", 0 if no error occurred.
+ */
+int cmdf_parser_parse(const cmdf_parser *parser, option_parse_function parse_function, int argc, char **argv, void *extern_user_variables_struct);
+
+
+/**
+ * @brief Parses a command line with a compiled parser, just as "cmdf_parser_parse", also reporting every error found on a result.
+ * @param parser: Parser made by "cmdf_parser_create".
+ * @param parse_function: User defined parse function pointer, may be NULL when every option is bound to a member and floating arguments are not needed.
+ * @param argc: Number of arguments in argv.
+ * @param argv: Array of strings containing the arguments, the first one is taken as the program name and skipped.
+ * @param extern_user_variables_struct: Opaque pointer to user define struct in main program, used to be accessed in the also user define parser function.
+ * @param result: Result to receive the errors, the options it points to belong to the parser.
+ * @return Returns the code of the first error found, see "PARSER_ERRORS_Typedef", 0 if no error occurred.
+ */
+int cmdf_parser_parse_result(const cmdf_parser *parser, option_parse_function parse_function, int argc, char **argv, void *extern_user_variables_struct, cmdf_result *result);
+
+
+/**
+ * @brief Parses a command line just as "cmdf_parser_parse_result", giving every argument to the view function as a pointer and a length.
+ * Each argument is measured once, by the parser, when it is given to the view function. Bound options are written as in any parse.
+ * @param parser: Parser made by "cmdf_parser_create".
+ * @param view_function: User defined view function pointer, may be NULL when every option is bound to a member and floating arguments are not needed.
+ * @param argc: Number of arguments in argv.
+ * @param argv: Array of strings containing the arguments, the first one is taken as the program name and skipped.
+ * @param extern_user_variables_struct: Opaque pointer to user define struct in main program, used to be accessed in the view function.
+ * @param result: Result to receive the errors, the options it points to belong to the parser.
+ * @return Returns the code of the first error found, see "PARSER_ERRORS_Typedef", 0 if no error occurred.
+ */
+int cmdf_parser_parse_views(const cmdf_parser *parser, option_view_function view_function, int argc, char **argv, void *extern_user_variables_struct, cmdf_result *result);
+
+
+/**
+ * @brief Parses a command line just as "cmdf_parser_parse_result", giving every option to the wide parse function by its id instead of its char key.
+ * 
+ * With PARSER_FLAG_WIDE_KEYS the options with (OPTION_NO_CHAR_KEY) are not limited by the 256 char keys, so a parser can have
+ * thousands of long options, each told apart by its id. Their key is then unused and can be left 0. Without the flag the id
+ * of every option is its char key, unless given.
+ * The long only options of such a parser have no char key to give, to a parse, view or span function they would look like
+ * floating arguments. So this is the only function that parses it with a user function: the other parse functions, the
+ * streams, strings, batches and command trees included, refuse it with PARSER_ERROR_WIDE_KEYS when given a parse or view
+ * function, and every parse does when it has a span function. They still parse it with a NULL function, for bound options.
+ * @param parser: Parser made by "cmdf_parser_create".
+ * @param wide_function: User defined wide parse function pointer, may be NULL when every option is bound to a member and floating arguments are not needed.
+ * @param argc: Number of arguments in argv.
+ * @param argv: Array of strings containing the arguments, the first one is taken as the program name and skipped.
+ * @param extern_user_variables_struct: Opaque pointer to user define struct in main program, used to be accessed in the wide parse function.
+ * @param result: Result to receive the errors, the options it points to belong to the parser.
+ * @return Returns the code of the first error found, see "PARSER_ERRORS_Typedef", 0 if no error occurred.
+ */
+int cmdf_parser_parse_wide(const cmdf_parser *parser, option_wide_function wide_function, int argc, char **argv, void *extern_user_variables_struct, cmdf_result *result);
+
+
+/**
+ * @brief Parses arguments read from a file descriptor, such as the output of "find -print0" on stdin.
+ * 
+ * Every argument ends with the delimiter, the last one may end with the stream instead. Each argument is parsed as soon as
+ * it is complete, so options that take many arguments receive them while the stream is still being read. Only a buffer of
+ * CMDF_STREAM_BUFFER_LENGTH bytes is used, on the stack of the call and never from the parser allocator, however many
+ * arguments come. An argument of CMDF_STREAM_BUFFER_LENGTH bytes or more is skipped with PARSER_ERROR_ARGUMENT_TOO_LONG,
+ * give a buffer of your own to "cmdf_parser_parse_fd_buffer" for longer arguments or for fewer reads.
+ * The arguments passed to the parse function live in that buffer, copy them to keep them after the call.
+ * There is no program name on the stream, the first argument has the index 0. Empty arguments are skipped, with '\n' as
+ * delimiter a '\r' before it is also removed.
+ * 
+ * @param parser: Parser made by "cmdf_parser_create".
+ * @param parse_function: User defined parse function pointer, may be NULL when every option is bound to a member and floating arguments are not needed.
+ * @param file_descriptor: Descriptor to read the arguments from, until the end of the stream.
+ * @param delimiter: Char that ends every argument, usually '\0' or '\n'.
+ * @param extern_user_variables_struct: Opaque pointer to user define struct in main program, used to be accessed in the also user define parser function.
+ * @param result: Result to receive the errors, NULL if not needed.
+ * @return Returns the code of the first error found, see "PARSER_ERRORS_Typedef", 0 if no error occurred.
+ */
+int cmdf_parser_parse_fd(const cmdf_parser *parser, option_parse_function parse_function, int file_descriptor, char delimiter, void *extern_user_variables_struct, cmdf_result *result);
+
+
+/**
+ * @brief Parses arguments read from a file descriptor just as "cmdf_parser_parse_fd", in a buffer given by the caller.
+ * The buffer can be of any size, from the heap or a static block, so long arguments can be streamed without a large
+ * stack. The arguments passed to the parse function live in it, an argument of "buffer_size" bytes or more is skipped.
+ * @param parser: Parser made by "cmdf_parser_create".
+ * @param parse_function: User defined parse function pointer, may be NULL when every option is bound to a member and floating arguments are not needed.
+ * @param file_descriptor: Descriptor to read the arguments from, until the end of the stream.
+ * @param delimiter: Char that ends every argument, usually '\0' or '\n'.
+ * @param buffer: Buffer the stream is read into, only used during the call.
+ * @param buffer_size: Size of the buffer, at least 2 bytes.
+ * @param extern_user_variables_struct: Opaque pointer to user define struct in main program, used to be accessed in the also user define parser function.
+ * @param result: Result to receive the errors, NULL if not needed.
+ * @return Returns the code of the first error found, see "PARSER_ERRORS_Typedef", 0 if no error occurred.
+ *         A buffer smaller than 2 bytes is reported as PARSER_ERROR_ARGUMENT_TOO_LONG, nothing is read.
+ */
+int cmdf_parser_parse_fd_buffer(const cmdf_parser *parser, option_parse_function parse_function, int file_descriptor, char delimiter, char *buffer, size_t buffer_size, void *extern_user_variables_struct, cmdf_result *result);
+
+
+/**
+ * @brief Parses the arguments of a command string, splitting it with the rules of "cmdf_args_tokenize".
+ * 
+ * Each argument is parsed as soon as it is split, nothing is allocated. The string is changed in place and the arguments
+ * passed to the parse function point into it. The string holds only arguments, there is no program name, the first
+ * argument has the index 0.
+ * 
+ * @param parser: Parser made by "cmdf_parser_create".
+ * @param parse_function: User defined parse function pointer, may be NULL when every option is bound to a member and floating arguments are not needed.
+ * @param command: Command string, changed by the split.
+ * @param extern_user_variables_struct: Opaque pointer to user define struct in main program, used to be accessed in the also user define parser function.
+ * @param result: Result to receive the errors, NULL if not needed.
+ * @return Returns the code of the first error found, see "PARSER_ERRORS_Typedef", 0 if no error occurred.
+ */
+int cmdf_parser_parse_string(const cmdf_parser *parser, option_parse_function parse_function, char *command, void *extern_user_variables_struct, cmdf_result *result);
+
+
+/**
+ * @brief Parses many command lines with the same parser, spread over a pool of threads.
+ * Every command line is parsed just as in "cmdf_parser_parse_result" and has its result written to its own item, so the results keep the input order.
+ * The user parse function is called from many threads at the same time, each item should point to its own user struct.
+ * Without the flag PARSER_FLAG_NOT_EXIT_ON_ERROR the first error exits the whole program, as in any other parse.
+ * @param parser: Parser made by "cmdf_parser_create".
+ * @param parse_function: User defined parse function pointer, may be NULL when every option is bound to a member and floating arguments are not needed.
+ * @param items: Array of command lines to be parsed.
+ * @param items_len: Number of command lines in items.
+ * @param threads: Number of threads to use, the calling thread included, at most 64. 0 or less uses one thread for each online processor.
+ * @return Returns the number of command lines that had errors.
+ */
+int cmdf_parser_parse_batch(const cmdf_parser *parser, option_parse_function parse_function, cmdf_batch_item *items, int items_len, int threads);
+
+
+/**
+ * @brief Set the usage info printed by --help for a single parser, replacing the value copied from "set_cmdf_default_info_usage".
+ * @param parser: Parser made by "cmdf_parser_create".
+ * @param info_string: Const string with desired information.
+ */
+void cmdf_parser_set_info_usage(cmdf_parser *parser, const char *info_string);
+
+
+/**
+ * @brief Set the version info printed by --version for a single parser, replacing the value copied from "set_cmdf_default_info_version".
+ * @param parser: Parser made by "cmdf_parser_create".
+ * @param info_string: Const string with desired information.
+ */
+void cmdf_parser_set_info_version(cmdf_parser *parser, const char *info_string);
+
+
+/**
+ * @brief Set the contact info printed by --info for a single parser, replacing the value copied from "set_cmdf_default_info_contact_info".
+ * @param parser: Parser made by "cmdf_parser_create".
+ * @param info_string: Const string with desired information.
+ */
+void cmdf_parser_set_info_contact_info(cmdf_parser *parser, const char *info_string);
+
+
+/**
+ * @brief Set the stream where the default options (--help, --info, --version) of a parser write to, stdout by default.
+ * Each default option is written with the stream locked, so texts written from other threads don't get mixed in.
+ * @param parser: Parser made by "cmdf_parser_create".
+ * @param output: Stream to write to, NULL for stdout.
+ */
+void cmdf_parser_set_output(cmdf_parser *parser, FILE *output);
+
+
+/**
+ * @brief Set a function that receives the arguments of the options of a parser in runs, instead of one call of the parse function per argument.
+ * 
+ * When parsing an argv, the arguments that follow an option are given at once as a part of argv, "argv + start" and their count,
+ * when the option ends, so an option with 200000 paths makes a single call. The values of an option in the config file are
+ * a single run as well. Other arguments that are not in an argv, such as the value of "--name=value" or the arguments of
+ * streams and strings, come as runs of one.
+ * Options without arguments, bound options and floating arguments still go to the parse function.
+ * The span function receives char keys, a parser with PARSER_FLAG_WIDE_KEYS then refuses to parse, see "cmdf_parser_parse_wide".
+ * @param parser: Parser made by "cmdf_parser_create".
+ * @param span_function: Function to receive the runs, NULL to give every argument to the parse function again.
+ */
+void cmdf_parser_set_span_function(cmdf_parser *parser, option_span_function span_function);
+
+
+/**
+ * @brief Set the constraints between the options of a parser, checked at the end of every parse with the required options.
+ * 
+ * The constraints are compiled here to one bitset per constraint, so a parse checks each of them with a few operations per
+ * word of 64 options, however many options the parser has. Options given by the environment or the config file count.
+ * Nothing is checked when a default option was given. Broken constraints are reported as PARSER_ERROR_CONSTRAINT, as in:
+ * "The options --json and --xml can't be given together". Not to be called while the parser is in use by a parse.
+ * 
+ * @param parser: Parser made by "cmdf_parser_create".
+ * @param constraints: Constraints, ended by an empty one, NULL to drop the constraints set before. Not needed after the call.
+ * @return Returns 0 on success, PARSER_ERROR_INVALID_CONSTRAINT if a constraint names an unknown option or too few options,
+ * that constraint is then left out, or PARSER_ERROR_OUT_OF_MEMORY. Only returns on errors with the flag PARSER_FLAG_NOT_EXIT_ON_ERROR.
+ */
+int cmdf_parser_set_constraints(cmdf_parser *parser, const cmdf_constraint *constraints);
+
+
+/**
+ * @brief Loads a config file giving the options that are not on the command line, for every parse of a parser.
+ * 
+ * Each line names an option by its long name, followed by its arguments: "name = value", "name value1 value2" or just
+ * "name" for options without arguments. The arguments are split as in a response file. Empty lines and lines starting
+ * with '#' or ';' are skipped, and a later line of an option replaces an earlier one.
+ * The file is mapped in memory and split in place once, here, so the values point into the file and are never copied.
+ * 
+ * On every parse an option, or its aliases, missing from the command line takes its value from its environment variable
+ * ("env_name" of "cmdf_option") and else from the config file: the command line goes over the environment, which goes over
+ * the file. These values are given to the parse function and the bindings after the command line, with the argument index -1,
+ * and they count for the required options. An environment variable is a single argument, an option without arguments is
+ * given when its variable is set and not empty nor "0". Nothing is taken from either when a default option was given.
+ * 
+ * Unknown names are reported as PARSER_ERROR_INVALID_OPTION with PARSER_FLAG_DONT_IGNORE_NON_REGISTERED_OPTIONS, and
+ * ignored otherwise. Not to be called while the parser is in use by a parse.
+ * 
+ * @param parser: Parser made by "cmdf_parser_create".
+ * @param path: Path of the config file, NULL to drop the config file loaded before.
+ * @return Returns 0 on success, PARSER_ERROR_CONFIG_FILE if the file can't be read, the code of the first error found in
+ * the file or PARSER_ERROR_OUT_OF_MEMORY. Only returns on errors with the flag PARSER_FLAG_NOT_EXIT_ON_ERROR.
+ */
+int cmdf_parser_set_config_file(cmdf_parser *parser, const char *path);
+
+
+/**
+ * @brief Expands the response files of a command line, replacing every argument "@path" by the arguments written in the file "path".
+ * 
+ * On POSIX systems the file is mapped in memory and split in place, the arguments point into the mapped file and are never copied,
+ * only the array of pointers is allocated. Arguments are separated by white space, single or double quotes keep white space inside
+ * an argument and a backslash escapes the next char (but not inside single quotes). Response files may name other response files,
+ * up to 16 levels. The first argument is the program name and is never expanded.
+ * The expanded "argc" and "argv" can be given to any parse function.
+ * 
+ * @param args: Receives the expanded command line, to be released with "cmdf_args_free" even on errors.
+ * @param argc: Number of arguments in argv.
+ * @param argv: Array of strings containing the arguments.
+ * @param allocator: Allocator for the argv array, NULL uses the C library malloc.
+ * @return Returns 0 on success, PARSER_ERROR_RESPONSE_FILE if a file can't be read, its path goes to "args->error_path", or PARSER_ERROR_OUT_OF_MEMORY.
+ */
+int cmdf_args_expand(cmdf_args *args, int argc, char **argv, const cmdf_allocator *allocator);
+
+
+/**
+ * @brief Splits a command string in arguments, as a shell would, giving an argv that points into the string.
+ * 
+ * Arguments are separated by white space, single or double quotes keep white space inside an argument and a backslash
+ * escapes the next char (but not inside single quotes). The string is changed in place: quotes and escapes are removed and
+ * every argument is ended by a zero, so no argument is copied and only the argv array is allocated. The string must outlive
+ * the arguments. Parse functions take the first argument as the program name, just as in the main argv.
+ * 
+ * @param args: Receives the arguments, to be released with "cmdf_args_free" even on errors.
+ * @param command: Command string, changed by the split.
+ * @param allocator: Allocator for the argv array, NULL uses the C library malloc.
+ * @return Returns 0 on success, PARSER_ERROR_OUT_OF_MEMORY if there is no memory for the argv array.
+ */
+int cmdf_args_tokenize(cmdf_args *args, char *command, const cmdf_allocator *allocator);
+
+
+/**
+ * @brief Releases a command line expanded by "cmdf_args_expand", arguments read from response files can't be used anymore.
+ * @param args: Expanded command line.
+ */
+void cmdf_args_free(cmdf_args *args);
+
+
+/**
+ * @brief Finds the registered option whose long name is the closest to a misspelled one, as suggested by the errors of
+ * unknown options ("Did you mean --name?"). Two edits are allowed, one for names of up to 5 chars, an edit being an
+ * inserted, removed or changed char or two adjacent chars swapped. Hidden options are never suggested.
+ * The long names are indexed by bigrams on the first call, so only the names sharing enough of them are compared.
+ * @param parser: Parser made by "cmdf_parser_create".
+ * @param name: The misspelled name, without the "--".
+ * @return Returns the long name of the closest option, NULL if no option is close enough.
+ */
+const char *cmdf_parser_suggest(const cmdf_parser *parser, const char *name);
+
+
+/**
+ * @brief Writes the completions of a word of a command line, one per line, as asked by the shell on every TAB.
+ * 
+ * A word starting with '-' is completed with the long names starting with the rest of the word, leaving out hidden options,
+ * options without long name and options already given before the cursor, but for counters and lists. An option and its
+ * aliases are offered once, by the first name that matches. After an option with an enum binding the word is completed
+ * with its values, and with the subcommand names where a subcommand can go. Otherwise nothing is written, and the shell
+ * falls back to file names.
+ * The long names are looked up in a trie, built on the first completion, or already in the tables of generated parsers.
+ * 
+ * With PARSER_FLAG_ENABLE_COMPLETION the parse functions answer "prog --__complete <cursor> <words...>" by themselves,
+ * and "prog --__complete-script bash", "zsh" or "fish" with the script that registers the completion on that shell,
+ * as in: source <(prog --__complete-script bash). The program then exits, with any flags.
+ * 
+ * @param parser: Parser made by "cmdf_parser_create".
+ * @param cursor: Index in "words" of the word being completed, "words_len" for a new word.
+ * @param words_len: Number of words.
+ * @param words: The command line as the shell has it, the program name first.
+ * @param out: Stream to write to, NULL for stdout.
+ * @return Returns the number of completions written.
+ */
+int cmdf_parser_complete(const cmdf_parser *parser, int cursor, int words_len, char **words, FILE *out);
+
+
+/**
+ * @brief Releases a parser made by "cmdf_parser_create".
+ * @param parser: Parser to be released, may be NULL.
+ */
+void cmdf_parser_free(cmdf_parser *parser);
+
+
+/**
+ * @brief Makes a tree of commands to parse git-style command lines. Nothing is compiled here, each command gets its parser
+ * the first time a command line selects it, so the startup cost doesn't depend on the number of commands.
+ * @param root: The program, whose options and subcommands come first on the command line. Must outlive the tree.
+ * @param flags: Flags of the parser of every command, see "PARSER_FLAGS_Typedef".
+ * @return Returns the tree, NULL if there is no memory.
+ */
+cmdf_command_tree *cmdf_command_tree_create(cmdf_command *root, PARSER_FLAGS_Typedef flags);
+
+
+/**
+ * @brief Parses a command line with a tree of commands.
+ * 
+ * Arguments are parsed with the parser of the root until the name of one of its subcommands comes, where a floating
+ * argument would go: after an option without arguments or after all the arguments of an option. The arguments after it are
+ * parsed with the parser of that subcommand, and so on. Each option calls the parse function of the command being parsed,
+ * and the required options are checked once at the end with the parser of the last command. --help lists the options
+ * and the subcommands of the command it is given to.
+ * Parsers of the selected commands are compiled here on first use and kept in the tree, trees can be shared between threads.
+ * 
+ * @param tree: Tree made by "cmdf_command_tree_create".
+ * @param argc: Number of arguments in argv.
+ * @param argv: Array of strings containing the arguments, the first one is the program name.
+ * @param extern_user_variables_struct: Opaque pointer passed to the parse functions.
+ * @param result: Receives every error found.
+ * @param command: Receives the last command selected, the root when no subcommand was given. May be NULL.
+ * @return Returns the code of the first error found, see "PARSER_ERRORS_Typedef", 0 if no error occurred.
+ */
+int cmdf_command_tree_parse(const cmdf_command_tree *tree, int argc, char **argv, void *extern_user_variables_struct, cmdf_result *result, const cmdf_command **command);
+
+
+/**
+ * @brief Releases a tree of commands and the parsers compiled for it.
+ * @param tree: Tree to be released, may be NULL.
+ */
+void cmdf_command_tree_free(cmdf_command_tree *tree);
+
+
+/**
+ * @brief Gets the statistics of the last parse made by the calling thread, any of the parse functions.
+ * When the environment variable CMDF_STATS is set the statistics are also written to stderr at the end of every parse.
+ * Without CMDF_ENABLE_STATS defined when compiling the library nothing is recorded and the statistics are all 0.
+ * @param stats: Receives the statistics.
+ */
+void cmdf_stats_get(cmdf_stats *stats);
+
+
 #endif
 
 
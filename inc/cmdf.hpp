@@ -0,0 +1,548 @@
+/**
+ * @file cmdf.hpp
+ *
+ * CMD_Friend - The Command line friend library!
+ *
+ * Header only C++17 layer over "cmdf.h". The options are a constexpr table where each option is bound to a member of
+ * the program struct, so there is no parse function to write and no void pointer to cast:
+ *
+ * ```cpp
+ *      struct settings
+ *      {
+ *          std::string_view where;
+ *          bool verbose = false;
+ *          int level = 0;
+ *          std::vector<std::string_view> tags;
+ *      };
+ *
+ *      inline constexpr auto settings_table = cmdf::make_table(PARSER_FLAG_USE_PREDEFINED_OPTIONS,
+ *          cmdf::option<&settings::where>("where", 'w', "Where to create the project", 0),   // 0: required
+ *          cmdf::alias("file", 'f'),
+ *          cmdf::option<&settings::verbose>("verbose", 'v', "Verbose mode"),
+ *          cmdf::counter<&settings::level>("level", 'l', "Raises the log level, repeat for more"),
+ *          cmdf::option<&settings::tags>("tags", 't', "Tags to put in"));
+ *
+ *      static_assert(settings_table.key_of("tags") == 't');
+ *
+ *      settings s;
+ *      cmdf::parse<settings_table>(argc, argv, s);
+ * ```
+ *
+ * What an option does comes from the type of its member: a bool is set by the option alone, a number or a string
+ * takes one argument and a std::vector takes any number of them. Numbers are converted with std::from_chars, without
+ * locale nor allocation, strings are std::string_view or const char* pointing into argv.
+ *
+ * The table is checked at compile time, duplicated keys or long names don't compile. Options without a char key get one
+ * automatically. The keys are constants of the table, so the single function given to the library resolves them with
+ * an inlined chain of comparisons, there is no user callback behind it.
+ *
+ */
+
+
+#ifndef __CMD_FRIEND_HPP
+#define __CMD_FRIEND_HPP
+
+/* Includes and dependencies */
+
+#include "cmdf.h"
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace cmdf
+{
+
+/* -------------------------------------------- Bindings ------------------------------------------------------- */
+
+
+/**
+ * @brief What an option does to its member.
+ */
+enum class action
+{
+    set_true,       /**< Sets a bool, takes no arguments */
+    count,          /**< Adds one to a number every time the option is given, takes no arguments */
+    store,          /**< Converts its argument to the member type, takes one argument */
+    append,         /**< Converts every argument and appends them to a std::vector, takes any number of arguments */
+    alias           /**< Does what the option above does */
+};
+
+
+namespace detail
+{
+    template<class T> struct member_traits;
+
+    template<class C, class F> struct member_traits<F C::*>
+    {
+        using class_type = C;
+        using field_type = F;
+    };
+
+    template<class T> struct is_vector : std::false_type {};
+    template<class T, class A> struct is_vector<std::vector<T, A>> : std::true_type {};
+
+    template<class T> inline constexpr bool dependent_false = false;
+}
+
+
+/**
+ * @brief An option bound to a member of the program struct, made by "option", "counter" or "positional".
+ */
+template<auto Member>
+struct binding
+{
+    using target_type = typename detail::member_traits<decltype(Member)>::class_type;      /**< The program struct */
+    using field_type = typename detail::member_traits<decltype(Member)>::field_type;       /**< Type of the member */
+
+    static constexpr auto member = Member;
+
+    const char *long_name;                          /**< Name called with "--", NULL for positional arguments */
+    char key;                                       /**< Char key called with "-", 0 to get one automatically */
+    const char *description;                        /**< Small description of the option */
+    OPTIONS_Typedef parameters;                     /**< Parameters of the option, see "OPTIONS_Typedef" */
+    int argq;                                       /**< Number of arguments, given by the action */
+    action act;                                     /**< What the option does to the member */
+};
+
+
+/**
+ * @brief Another name for the option above it, made by "alias".
+ */
+struct alias_binding
+{
+    using target_type = void;
+
+    const char *long_name;                          /**< Name called with "--" */
+    char key;                                       /**< Char key called with "-", 0 to get one automatically */
+    const char *description;                        /**< Unused, aliases take the description of their option */
+    OPTIONS_Typedef parameters;                     /**< Always OPTION_ALIAS */
+    int argq;                                       /**< Unused, aliases take the arguments of their option */
+    action act;                                     /**< Always action::alias */
+};
+
+
+/**
+ * @brief Binds an option to a member, its action given by the member type: bool members are set, std::vector members
+ * append any number of arguments and every other member stores one converted argument.
+ * @param long_name: Name called with "--".
+ * @param key: Char key called with "-", 0 for an option with only the long name.
+ * @param description: Small description of the option.
+ * @param parameters: Parameters of the option, see "OPTIONS_Typedef", 0 for a required option.
+ */
+template<auto Member>
+constexpr binding<Member> option(const char *long_name, char key, const char *description, OPTIONS_Typedef parameters = OPTION_OPTIONAL)
+{
+    using field_type = typename binding<Member>::field_type;
+
+    if constexpr(std::is_same_v<field_type, bool>)
+        return {long_name, key, description, parameters, 0, action::set_true};
+    else if constexpr(detail::is_vector<field_type>::value)
+        return {long_name, key, description, parameters, -1, action::append};
+    else
+        return {long_name, key, description, parameters, 1, action::store};
+}
+
+
+/**
+ * @brief Binds an option without arguments to a number member, incremented every time the option is given.
+ * @param long_name: Name called with "--".
+ * @param key: Char key called with "-", 0 for an option with only the long name.
+ * @param description: Small description of the option.
+ * @param parameters: Parameters of the option, see "OPTIONS_Typedef", 0 for a required option.
+ */
+template<auto Member>
+constexpr binding<Member> counter(const char *long_name, char key, const char *description, OPTIONS_Typedef parameters = OPTION_OPTIONAL)
+{
+    static_assert(std::is_arithmetic_v<typename binding<Member>::field_type>, "a counter must be bound to a number");
+
+    return {long_name, key, description, parameters, 0, action::count};
+}
+
+
+/**
+ * @brief Binds the arguments that don't belong to any option to a member, a std::vector receives all of them and any
+ * other member the last one.
+ */
+template<auto Member>
+constexpr binding<Member> positional()
+{
+    using field_type = typename binding<Member>::field_type;
+
+    return {nullptr, 0, nullptr, OPTION_OPTIONAL, -1, detail::is_vector<field_type>::value ? action::append : action::store};
+}
+
+
+/**
+ * @brief Another name for the option above it.
+ * @param long_name: Name called with "--".
+ * @param key: Char key called with "-", 0 for an alias with only the long name.
+ */
+constexpr alias_binding alias(const char *long_name, char key = 0)
+{
+    return {long_name, key, nullptr, OPTION_ALIAS, 0, action::alias};
+}
+
+
+/* -------------------------------------------- Table ---------------------------------------------------------- */
+
+
+namespace detail
+{
+    // never defined as constexpr, a table that calls one of these can't be a constant and the compiler names the problem
+    inline void error_duplicated_key() {}
+    inline void error_duplicated_long_name() {}
+    inline void error_no_free_key() {}
+    inline void error_alias_without_option() {}
+    inline void error_many_positional() {}
+
+    constexpr bool is_letter(char key)
+    {
+        return (key >= 'a' && key <= 'z') || (key >= 'A' && key <= 'Z');
+    }
+
+    constexpr bool is_reserved_key(char key)
+    {
+        return key == 0 || key == __HELP_KEY || key == __VERSION_KEY || key == __INFO_KEY;
+    }
+
+    constexpr bool same_name(const char *a, const char *b)
+    {
+        return a != nullptr && b != nullptr && std::string_view(a) == std::string_view(b);
+    }
+}
+
+
+/**
+ * @brief Options table, made by "make_table". Holds the options as constants, the members they are bound to are in the type.
+ */
+template<class Target, class... Bindings>
+struct table
+{
+    using target_type = Target;                     /**< The program struct */
+    using bindings_type = std::tuple<Bindings...>;  /**< Type of every binding, in order */
+
+    static constexpr std::size_t size = sizeof...(Bindings);
+
+    PARSER_FLAGS_Typedef flags;                     /**< Flags of the parser */
+    std::array<const char*, size> long_names;       /**< Long name of every option, NULL for positional arguments */
+    std::array<char, size> keys;                    /**< Key of every option as registered, automatic keys included, 0 for positional arguments */
+    std::array<const char*, size> descriptions;     /**< Description of every option */
+    std::array<OPTIONS_Typedef, size> parameters;   /**< Parameters of every option */
+    std::array<int, size> argqs;                    /**< Number of arguments of every option */
+    std::array<action, size> actions;               /**< Action of every option */
+    std::array<std::size_t, size> targets;          /**< Index of the binding that does the work, the option above for aliases */
+
+    constexpr table(PARSER_FLAGS_Typedef flags, Bindings... bindings)
+        : flags(flags), long_names{bindings.long_name...}, keys{bindings.key...}, descriptions{bindings.description...},
+          parameters{bindings.parameters...}, argqs{bindings.argq...}, actions{bindings.act...}, targets{}
+    {
+        static_assert(((std::is_same_v<typename Bindings::target_type, Target> || std::is_same_v<typename Bindings::target_type, void>) && ...),
+                      "every option of a table must be bound to the same struct");
+
+        int positional_count = 0;
+
+        for(std::size_t i = 0; i < size; i++)
+        {
+            targets[i] = i;
+
+            if(actions[i] == action::alias)
+            {
+                if(i == 0 || actions[i - 1] == action::alias || long_names[i - 1] == nullptr)
+                    detail::error_alias_without_option();
+
+                targets[i] = targets[i - 1];
+            }
+
+            if(long_names[i] == nullptr && ++positional_count > 1)
+                detail::error_many_positional();
+
+            for(std::size_t j = 0; j < i; j++)
+            {
+                if(keys[i] != 0 && keys[i] == keys[j])
+                    detail::error_duplicated_key();
+
+                if(detail::same_name(long_names[i], long_names[j]))
+                    detail::error_duplicated_long_name();
+            }
+
+            if(long_names[i] != nullptr && (keys[i] == __HELP_KEY || keys[i] == __VERSION_KEY || keys[i] == __INFO_KEY))
+                detail::error_duplicated_key();
+        }
+
+        // options without a char key get the first free key that is not a letter
+        for(std::size_t i = 0; i < size; i++)
+        {
+            if(long_names[i] == nullptr || keys[i] != 0)
+                continue;
+
+            char candidate = 1;
+
+            while(candidate < 127 && (detail::is_letter(candidate) || detail::is_reserved_key(candidate) || key_taken(candidate)))
+                candidate++;
+
+            if(candidate >= 127)
+                detail::error_no_free_key();
+
+            keys[i] = candidate;
+
+            if(actions[i] != action::alias)
+                parameters[i] = (OPTIONS_Typedef)(parameters[i] | OPTION_NO_CHAR_KEY);
+        }
+    }
+
+    /**
+     * @brief Key of an option, usable at compile time.
+     * @param long_name: Long name of the option.
+     * @return Returns the key, 0 if there is no option with that name.
+     */
+    constexpr char key_of(std::string_view long_name) const
+    {
+        for(std::size_t i = 0; i < size; i++)
+        {
+            if(long_names[i] != nullptr && long_name == long_names[i])
+                return keys[i];
+        }
+
+        return 0;
+    }
+
+private:
+
+    constexpr bool key_taken(char key) const
+    {
+        for(std::size_t i = 0; i < size; i++)
+        {
+            if(keys[i] == key)
+                return true;
+        }
+
+        return false;
+    }
+};
+
+
+/**
+ * @brief Makes an options table, the program struct is the one of the first option.
+ * Declare the table "inline constexpr" at namespace scope so it can be given to "parse".
+ * @param flags: Flags of the parser, see "PARSER_FLAGS_Typedef".
+ * @param first: First option.
+ * @param rest: Other options.
+ */
+template<class First, class... Rest>
+constexpr table<typename First::target_type, First, Rest...> make_table(PARSER_FLAGS_Typedef flags, First first, Rest... rest)
+{
+    return table<typename First::target_type, First, Rest...>(flags, first, rest...);
+}
+
+
+/* -------------------------------------------- Parsing -------------------------------------------------------- */
+
+
+namespace detail
+{
+    template<const auto &Table>
+    using table_of = std::remove_cv_t<std::remove_reference_t<decltype(Table)>>;
+
+    template<class Target>
+    struct context
+    {
+        Target *target;
+        PARSER_FLAGS_Typedef flags;
+        cmdf_result *result;
+    };
+
+
+    /**
+     * @brief Converts an argument to the type of a member, numbers must be entirely valid and fit in the type.
+     * @return Returns true on success, the value is untouched otherwise.
+     */
+    template<class T>
+    bool convert(const char *text, T &value)
+    {
+        if constexpr(std::is_same_v<T, std::string_view> || std::is_same_v<T, const char*>)
+        {
+            value = text;
+            return true;
+        }
+        else if constexpr(std::is_same_v<T, char*>)
+        {
+            value = const_cast<char*>(text);
+            return true;
+        }
+        else if constexpr(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>)
+        {
+            std::string_view view(text);
+            T parsed{};
+            auto [end, error] = std::from_chars(view.data(), view.data() + view.size(), parsed);
+
+            if(error != std::errc() || end != view.data() + view.size() || view.empty())
+                return false;
+
+            value = parsed;
+            return true;
+        }
+        else
+        {
+            static_assert(dependent_false<T>, "no conversion from an argument to this member type");
+            return false;
+        }
+    }
+
+
+    /**
+     * @brief Records and prints a value that could not be converted, just as the library reports its own errors.
+     */
+    inline void invalid_value(PARSER_FLAGS_Typedef flags, cmdf_result *result, const char *long_name, const char *value)
+    {
+        if(result->error_count < CMDF_MAX_ERRORS)
+            result->errors[result->error_count] = cmdf_error{PARSER_ERROR_INVALID_VALUE, -1, nullptr};
+
+        result->error_count++;
+
+        FILE *out = nullptr;
+
+        if(flags & PARSER_FLAG_PRINT_ERRORS_STDOUT)
+            out = stdout;
+        else if(flags & PARSER_FLAG_PRINT_ERRORS_STDERR)
+            out = stderr;
+        else if(!(flags & PARSER_FLAG_NOT_EXIT_ON_ERROR))
+            out = stdout;
+
+        if(out != nullptr)
+        {
+            if(long_name != nullptr)
+                fprintf(out, "The value \"%s\" is not valid for the option --%s.\n", value, long_name);
+            else
+                fprintf(out, "The argument \"%s\" is not valid.\n", value);
+        }
+
+        if(!(flags & PARSER_FLAG_NOT_EXIT_ON_ERROR))
+            exit(1);
+    }
+
+
+    template<const auto &Table, std::size_t I>
+    inline void apply(char *arg, context<typename table_of<Table>::target_type> &ctx)
+    {
+        using binding_type = std::tuple_element_t<I, typename table_of<Table>::bindings_type>;
+        using field_type = typename binding_type::field_type;
+
+        auto &field = ctx.target->*(binding_type::member);
+
+        if constexpr(Table.actions[I] == action::set_true)
+        {
+            field = true;
+        }
+        else if constexpr(Table.actions[I] == action::count)
+        {
+            field += 1;
+        }
+        else if constexpr(Table.actions[I] == action::append)
+        {
+            typename field_type::value_type value{};
+
+            if(convert(arg, value))
+                field.push_back(value);
+            else
+                invalid_value(ctx.flags, ctx.result, Table.long_names[I], arg);
+        }
+        else
+        {
+            if(!convert(arg, field))
+                invalid_value(ctx.flags, ctx.result, Table.long_names[I], arg);
+        }
+    }
+
+
+    // every comparison is against a constant key, so the fold is compiled as a switch, or a few compares for small tables
+    template<const auto &Table, std::size_t... I>
+    inline void dispatch(char key, char *arg, context<typename table_of<Table>::target_type> &ctx, std::index_sequence<I...>)
+    {
+        (void)((key == Table.keys[I] ? (apply<Table, Table.targets[I]>(arg, ctx), true) : false) || ...);
+    }
+
+
+    /**
+     * @brief The only parse function given to the library for a table.
+     */
+    template<const auto &Table>
+    int trampoline(char key, char *arg, int arg_pos, void *context_ptr)
+    {
+        auto &ctx = *static_cast<context<typename table_of<Table>::target_type>*>(context_ptr);
+
+        (void)arg_pos;
+        dispatch<Table>(key, arg, ctx, std::make_index_sequence<table_of<Table>::size>());
+
+        return 0;
+    }
+
+
+    /**
+     * @brief Parser of a table, compiled on first use and kept until the program ends.
+     */
+    template<const auto &Table>
+    cmdf_parser *compiled_parser()
+    {
+        static cmdf_parser *const parser = []
+        {
+            std::array<cmdf_option, table_of<Table>::size + 1> options{};
+            std::size_t count = 0;
+
+            for(std::size_t i = 0; i < table_of<Table>::size; i++)
+            {
+                if(Table.long_names[i] == nullptr) // positional arguments are not options
+                    continue;
+
+                cmdf_option &option = options[count++];
+
+                option.long_name = const_cast<char*>(Table.long_names[i]);
+                option.key = Table.keys[i];
+                option.parameters = Table.parameters[i];
+                option.argq = Table.argqs[i];
+                option.description = const_cast<char*>(Table.descriptions[i]);
+            }
+
+            return cmdf_parser_create(options.data(), Table.flags);
+        }();
+
+        return parser;
+    }
+}
+
+
+/**
+ * @brief Parses a command line into the program struct.
+ * @param argc: Number of arguments in argv.
+ * @param argv: Array of strings containing the arguments, the first one is taken as the program name and skipped.
+ * @param target: Program struct receiving the values.
+ * @param result: Result to receive the errors, NULL if not needed. Values that can't be converted are PARSER_ERROR_INVALID_VALUE errors.
+ * @return Returns the code of the first error found, see "PARSER_ERRORS_Typedef", 0 if no error occurred.
+ */
+template<const auto &Table>
+int parse(int argc, char **argv, typename detail::table_of<Table>::target_type &target, cmdf_result *result = nullptr)
+{
+    cmdf_parser *parser = detail::compiled_parser<Table>();
+    cmdf_result local_result;
+
+    if(parser == nullptr)
+        return PARSER_ERROR_OUT_OF_MEMORY;
+
+    if(result == nullptr)
+        result = &local_result;
+
+    detail::context<typename detail::table_of<Table>::target_type> ctx{&target, Table.flags, result};
+
+    return cmdf_parser_parse_result(parser, &detail::trampoline<Table>, argc, argv, &ctx, result);
+}
+
+
+}
+
+
+#endif
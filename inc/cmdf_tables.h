@@ -0,0 +1,160 @@
+/**
+ * @file cmdf_tables.h
+ *
+ * CMD_Friend - The Command line friend library!
+ *
+ * Layout of a compiled parser. Only needed by the library itself and by the parser tables written by the generator
+ * in "tools/cmdf_gen.c", programs should use the opaque "cmdf_parser" from "cmdf.h". This layout may change between
+ * versions, so generated tables must be generated again with the library they are compiled with.
+ *
+ */
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#ifndef __CMD_FRIEND_TABLES
+#define __CMD_FRIEND_TABLES
+
+/* Includes and dependencies */
+
+#include "cmdf.h"
+
+
+/* -------------------------------------------- Definitions ---------------------------------------------------- */
+
+
+#define KEY_MAP_LENGTH 0x100    // size of the direct mapped key tables, one entry for every possible char key
+
+#define NAME_TRIE_NO_OPTION (-1)    // no option is reached from a node of the long name trie
+#define NAME_TRIE_AMBIGUOUS (-2)    // more than one option is reached from a node of the long name trie
+
+
+/* -------------------------------------------- Structures ----------------------------------------------------- */
+
+
+/**
+ * @brief Options list of --help cached by the parser, private to the library.
+ */
+typedef struct cmdf_help cmdf_help;
+
+
+/**
+ * @brief Bigram index of the long names for the "Did you mean" suggestions, private to the library.
+ */
+typedef struct cmdf_suggest_index cmdf_suggest_index;
+
+
+/**
+ * @brief Values of the config file loaded by "cmdf_parser_set_config_file", private to the library.
+ */
+typedef struct cmdf_config cmdf_config;
+
+
+/**
+ * @brief Open addressing hash table that indexes the options by long name.
+ * Built once by "parse_registered_options", so looking up a "--name" argument costs the length of the name
+ * and not the number of registered options.
+ */
+typedef struct
+{
+    cmdf_option **slots;                            /**< Slot table, NULL means empty slot */
+    unsigned int *hashes;                           /**< Hash of the long name stored in each slot, checked before comparing names */
+    size_t *lengths;                                /**< Length of the long name stored in each slot */
+    unsigned int mask;                              /**< Number of slots minus one, the number of slots is a power of two */
+}cmdf_long_name_index;
+
+
+/**
+ * @brief Node of the long name trie. Every node holds a run of chars, so a path without branches is a single node.
+ */
+typedef struct
+{
+    unsigned int label;                             /**< Offset of the chars of the node in "labels" of the trie */
+    unsigned int label_length;                      /**< Number of chars of the node, only the root has none */
+    unsigned int children;                          /**< Index of the first child, the children are next to each other and sorted by their first char */
+    unsigned int children_len;                      /**< Number of children */
+    int exact;                                      /**< Option whose long name ends at the end of this node, NAME_TRIE_NO_OPTION if none */
+    int prefix;                                     /**< Option named by every name that goes through this node, not counting (OPTION_NO_LONG_KEY) and counting an option and its aliases once, or NAME_TRIE_AMBIGUOUS */
+}cmdf_name_trie_node;
+
+
+/**
+ * @brief Radix trie of the long names, built with PARSER_FLAG_ALLOW_ABBREVIATIONS.
+ * A name is looked up by walking down from the root, so it costs the length of the name and not the number of options.
+ * Whole names are looked up first in "long_name_index", which is faster, and only the names it doesn't have reach the trie.
+ */
+typedef struct
+{
+    cmdf_name_trie_node *nodes;                     /**< Nodes, the root first, NULL when the parser takes no abbreviations */
+    char *labels;                                   /**< Chars of every node */
+    unsigned int nodes_len;                         /**< Number of nodes */
+}cmdf_name_trie;
+
+
+/**
+ * @brief A constraint between options compiled by "cmdf_parser_set_constraints", its options are a bitset of "constraint_masks".
+ */
+typedef struct
+{
+    CONSTRAINTS_Typedef kind;                       /**< What is checked */
+    int subject;                                    /**< Option that requires or conflicts with the others, -1 for the other kinds */
+    int members;                                    /**< First option of the constraint in "constraint_members", the subject not counted */
+    int members_len;                                /**< Number of options of the constraint, the subject not counted */
+    int first_word;                                 /**< First word of its bitset holding one of its options, the words outside are never read */
+    int words;                                      /**< Number of words of its bitset from "first_word" up to its last option */
+}cmdf_constraint_check;
+
+
+/**
+ * @brief Compiled parser, the options prepared for parsing by "parse_registered_options".
+ * Every option is identified internally by its index in "options", which is also its bit in the option bitsets.
+ * Nothing in here changes while parsing, so a parser can be used for any number of parses.
+ *
+ * Generated parsers are static data: their allocator has no functions and they own no memory.
+ */
+struct cmdf_parser
+{
+    cmdf_allocator allocator;                       /**< Allocator of every table of the parser and of the parser itself */
+    PARSER_FLAGS_Typedef flags;                     /**< Flags given when the parser was created */
+    const char *info_usage;                         /**< Usage info printed by --help */
+    const char *info_version;                       /**< Version info printed by --version */
+    const char *info_contact_info;                  /**< Contact info printed by --info */
+    FILE *output;                                   /**< Stream where the default options write to, NULL for stdout */
+    option_span_function span_function;             /**< Receives the arguments of the options in runs, NULL to call the parse function for each one */
+    cmdf_option *options;                           /**< Default options followed by the user options, ended by an empty option */
+    int options_len;                                /**< Number of options, not counting the ending empty one */
+    cmdf_option *key_map[KEY_MAP_LENGTH];           /**< Key to option table, NULL for keys not registered */
+    cmdf_long_name_index long_name_index;           /**< Long name to option table */
+    cmdf_name_trie name_trie;                       /**< Long names and their abbreviations, only with PARSER_FLAG_ALLOW_ABBREVIATIONS */
+    int bitset_words;                               /**< Number of words of every option bitset */
+    unsigned long *default_mask;                    /**< Bitset of the library default options */
+    unsigned long *required_masks;                  /**< One bitset per required option, holding the option and its aliases, "required_len" * "bitset_words" words */
+    int *required_options;                          /**< Index of the option that each required bitset stands for */
+    int required_len;                               /**< Number of required options */
+    int *env_options;                               /**< Index of every option with an environment variable, in registration order */
+    int env_options_len;                            /**< Number of options with an environment variable */
+    cmdf_config *config;                            /**< Values of the config file, NULL without one */
+    cmdf_constraint_check *constraints;             /**< Constraints between options, NULL without them */
+    int constraints_len;                            /**< Number of constraints */
+    unsigned long *constraint_masks;                /**< One bitset per constraint holding its options, not its subject, "constraints_len" * "bitset_words" words */
+    int *constraint_members;                        /**< Options of every constraint, one after the other */
+    int *aliases;                                   /**< Index of every alias, that counts as its option for the constraints */
+    int aliases_len;                                /**< Number of aliases */
+    const char *help_text;                          /**< Options list of --help rendered in advance, NULL to render it when asked */
+    cmdf_help *help;                                /**< Options list of --help and its filter index, built on the first --help. Written after creation, as "suggest_index" */
+    cmdf_suggest_index *suggest_index;              /**< Index of the long names for suggestions, built on the first unknown option */
+    const cmdf_command *command;                    /**< Command of a command tree this parser was compiled for, its subcommands are listed by --help. NULL otherwise */
+    cmdf_stats prepare_stats;                       /**< Time and allocations of the preparation of the tables, recorded with CMDF_ENABLE_STATS */
+    cmdf_result registration_result;                /**< Errors found on the options array, reported by every parse when not exiting on errors */
+};
+
+
+#endif
+
+
+#ifdef __cplusplus
+}
+#endif
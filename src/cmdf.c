@@ -17,7 +17,49 @@ extern "C" {
 #endif 
 
 
-#include "cmdf.h"
+#include "cmdf_tables.h"
+#include <errno.h>
+#include <float.h>
+#include <limits.h>
+#include <locale.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <unistd.h>
+
+
+#if defined(_WIN32)
+#define flockfile(stream) _lock_file(stream)
+#define funlockfile(stream) _unlock_file(stream)
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#endif
+
+#if defined(__SSE2__) && defined(__GNUC__)
+#include <emmintrin.h>
+#define COMMAND_SCAN_SSE2
+#endif
+
+#if defined(CMDF_ENABLE_STATS)
+#include <time.h>
+
+#if defined(_MSC_VER)
+#define STATS_THREAD_LOCAL __declspec(thread)
+#else
+#define STATS_THREAD_LOCAL _Thread_local
+#endif
+
+#define STATS_ADD(field, value) (stats_current.field += (value))
+#define STATS_TIME_BEGIN(name) unsigned long long name = stats_now_ns()
+#define STATS_TIME_END(field, name) (stats_current.field += stats_now_ns() - (name))
+#else
+#define STATS_ADD(field, value) ((void)0)
+#define STATS_TIME_BEGIN(name) ((void)0)
+#define STATS_TIME_END(field, name) ((void)0)
+#endif
 
 
 /**
@@ -26,29 +68,428 @@ extern "C" {
 #define DEFAULT_OPTIONS_LENGTH 3
 
 
+/**
+ * @brief Index of a char key inside the key tables, keys are read as unsigned so negative chars map correctly.
+ */
+#define KEY_INDEX(key) ((unsigned char)(key))
+
+
+/**
+ * @brief Minimum number of slots of the long name index, always a power of two.
+ */
+#define LONG_NAME_INDEX_MIN_SLOTS 8
+
+
+/**
+ * @brief Number of bits in a word of an option bitset.
+ */
+#define BITSET_WORD_BITS (sizeof(unsigned long) * CHAR_BIT)
+
+
+/**
+ * @brief Number of words needed by a bitset with one bit for each of "bits" options.
+ */
+#define BITSET_WORDS(bits) (((bits) + BITSET_WORD_BITS - 1) / BITSET_WORD_BITS)
+
+
+/**
+ * @brief Sets the bit of the option at index "bit" on a bitset.
+ */
+#define BITSET_SET(bitset, bit) ((bitset)[(bit) / BITSET_WORD_BITS] |= (1UL << ((bit) % BITSET_WORD_BITS)))
+
+
+/**
+ * @brief Gets the bit of the option at index "bit" on a bitset.
+ */
+#define BITSET_TEST(bitset, bit) (((bitset)[(bit) / BITSET_WORD_BITS] >> ((bit) % BITSET_WORD_BITS)) & 1UL)
+
+
+/**
+ * @brief Number of command lines a batch worker takes from the queue at a time.
+ */
+#define BATCH_CHUNK_LENGTH 64
+
+
+/**
+ * @brief Most threads of a batch parse, the calling thread included, so the handles of the workers fit on the stack.
+ */
+#define BATCH_MAX_THREADS 64
+
+
+/**
+ * @brief Alignment of every block given by an arena, enough for any type used by the library.
+ */
+#define ARENA_ALIGNMENT 16
+
+
+/**
+ * @brief The "C" locale of the strtod fallback of "convert_float", so the process locale is never read.
+ */
+#if defined(_WIN32)
+#define c_locale_t _locale_t
+#define c_locale_new() _create_locale(LC_ALL, "C")
+#else
+#define c_locale_t locale_t
+#define c_locale_new() newlocale(LC_ALL_MASK, "C", (locale_t)0)
+#endif
+
+
+/**
+ * @brief Lower case of an ascii letter, any other char is kept.
+ */
+#define ASCII_LOWER(c) (((c) >= 'A' && (c) <= 'Z') ? (c) + ('a' - 'A') : (c))
+
+
+/**
+ * @brief First size of the text of a text builder, doubled when full.
+ */
+#define TEXT_BUILDER_INITIAL_CAPACITY 1024
+
+
+/**
+ * @brief Number of buckets of the trigram index of the help, a power of two.
+ */
+#define HELP_TRIGRAM_BUCKETS 4096
+
+
+/**
+ * @brief Pieces of text given to a single write of the help.
+ */
+#define HELP_WRITE_PIECES 64
+
+
+/**
+ * @brief Minimum number of buckets of the suggestion index, a power of two.
+ */
+#define SUGGEST_MIN_BUCKETS 64
+
+
+/**
+ * @brief Biggest edit distance of a suggestion, names of up to SUGGEST_SHORT_LENGTH chars only get suggestions at distance 1.
+ */
+#define SUGGEST_MAX_DISTANCE 2
+#define SUGGEST_SHORT_LENGTH 5
+
+
+/**
+ * @brief Longest name kept in the short names list of the suggestion index. Names of up to SUGGEST_SHORT_NAME - 1 chars may
+ * share no bigram at all with the names one edit away, those are searched in the list instead.
+ */
+#define SUGGEST_SHORT_NAME 3
+
+
+/**
+ * @brief Longest name that gets suggestions, longer names are not compared.
+ */
+#define SUGGEST_MAX_LENGTH 64
+
+
+/**
+ * @brief Char that pads the long names on both sides for their bigrams, never part of a name.
+ */
+#define SUGGEST_PAD 0x01
+
+
+/**
+ * @brief Options counted at a time by "suggest_option", the size of its counters on the stack.
+ */
+#define SUGGEST_WINDOW 2048
+
+
+/**
+ * @brief Most options named by the error of an ambiguous abbreviation, the others are left as "...".
+ */
+#define NAME_TRIE_CANDIDATES 8
+
+
+/**
+ * @brief Room for the names of an ambiguous abbreviation, the names that don't fit are left as "..." too.
+ */
+#define NAME_TRIE_CANDIDATES_LENGTH 256
+
+
+/**
+ * @brief Initial number of slots of the compiled commands table of a command tree, a power of two.
+ */
+#define COMMAND_TREE_MIN_SLOTS 16
+
+
+/**
+ * @brief Scripts that register the completion of a program on each shell, "@PROGRAM@" is replaced by the program name
+ * and "@FUNCTION@" by the same name with only letters, digits and '_'. Every TAB runs the program with "--__complete".
+ */
+#define COMPLETE_SCRIPT_BASH \
+    "_cmdf_complete_@FUNCTION@()\n" \
+    "{\n" \
+    "    local IFS=$'\\n'\n" \
+    "    COMPREPLY=($(\"${COMP_WORDS[0]}\" " CMDF_COMPLETE_OPTION " \"$COMP_CWORD\" \"${COMP_WORDS[@]}\" 2>/dev/null))\n" \
+    "}\n" \
+    "complete -o default -F _cmdf_complete_@FUNCTION@ @PROGRAM@\n"
+
+#define COMPLETE_SCRIPT_ZSH \
+    "#compdef @PROGRAM@\n" \
+    "_cmdf_complete_@FUNCTION@()\n" \
+    "{\n" \
+    "    local -a candidates\n" \
+    "    candidates=(\"${(@f)$(\"${words[1]}\" " CMDF_COMPLETE_OPTION " \"$((CURRENT - 1))\" \"${words[@]}\" 2>/dev/null)}\")\n" \
+    "    if [[ -n \"${candidates[1]}\" ]]; then\n" \
+    "        compadd -Q -- \"${candidates[@]}\"\n" \
+    "    else\n" \
+    "        _files\n" \
+    "    fi\n" \
+    "}\n" \
+    "compdef _cmdf_complete_@FUNCTION@ @PROGRAM@\n"
+
+#define COMPLETE_SCRIPT_FISH \
+    "function __cmdf_complete_@FUNCTION@\n" \
+    "    set -l words (commandline -opc) (commandline -ct)\n" \
+    "    $words[1] " CMDF_COMPLETE_OPTION " (math (count $words) - 1) $words 2>/dev/null\n" \
+    "end\n" \
+    "complete -c @PROGRAM@ -a '(__cmdf_complete_@FUNCTION@)'\n"
+
+
+/**
+ * @brief Maximum nesting of response files, also stops response files that include themselves.
+ */
+#define RESPONSE_FILE_MAX_DEPTH 16
+
+
+/**
+ * @brief Initial number of arguments room of an expanded argv, doubled when full.
+ */
+#define ARGS_INITIAL_CAPACITY 64
+
+
+/**
+ * @brief Room for the option names listed by a broken constraint, longer lists are cut.
+ */
+#define CONSTRAINT_NAMES_LENGTH 256
+
+
+/* -------------------------------------------- Private Structures ----------------------------------------------------- */
+
+/**
+ * @brief A response file loaded in memory, kept until the expanded arguments are released.
+ */
+typedef struct
+{
+    char *address;                                  /**< Start of the file content, followed by at least one writable byte */
+    size_t length;                                  /**< Length of the whole region, as needed to release it */
+}cmdf_args_mapping;
+
+
+/**
+ * @brief State of a parse in progress. Arguments are pushed one at a time by "parse_state_push",
+ * so the same parse works for an argv array and for arguments that arrive from a stream.
+ */
+typedef struct
+{
+    const cmdf_parser *parser;                      /**< Parser in use */
+    option_parse_function parse_function;           /**< User defined parse function */
+    option_view_function view_function;             /**< User defined view function, called instead of the parse function when set */
+    option_wide_function wide_function;             /**< User defined wide parse function, called with the ids instead of the parse function when set */
+    void *extern_user_variables_struct;             /**< User struct given to the parse function */
+    cmdf_result *result;                            /**< Result receiving the errors */
+    unsigned long *options_passed_bitset;           /**< The options given so far, one bit per option index */
+    cmdf_option *pending_option;                    /**< Option still taking arguments, NULL when there is none */
+    int pending_index;                              /**< Argument index of the pending option */
+    int pending_count;                              /**< Number of arguments taken so far by the pending option */
+    int argument_index;                             /**< Index of the next argument to be pushed */
+    char **argv;                                    /**< Command line being parsed, NULL when the arguments are not in an array */
+    int span_start;                                 /**< Index in "argv" of the run of arguments of the pending option not given yet to the span function */
+    int span_count;                                 /**< Number of arguments of that run */
+}cmdf_parse_state;
+
+
+/**
+ * @brief Text made by appending formatted pieces, see "text_builder_append".
+ */
+typedef struct
+{
+    const cmdf_allocator *allocator;                /**< Allocator of the text */
+    char *text;                                     /**< The text, always ended by '\0' once something was appended */
+    size_t length;                                  /**< Length of the text */
+    size_t capacity;                                /**< Size of the text block */
+    int failed;                                     /**< Set when an allocation failed, the text is then incomplete */
+}cmdf_text_builder;
+
+
+/**
+ * @brief A piece of text to be written, not ended by '\0'.
+ */
+typedef struct
+{
+    const char *text;                               /**< Start of the piece */
+    size_t length;                                  /**< Length of the piece */
+}cmdf_text_piece;
+
+
+/**
+ * @brief Options list of --help cached on a parser, with an index of the trigrams of its lines for "--help=filter".
+ * Made on the first --help by "help_build".
+ */
+struct cmdf_help
+{
+    const char *text;                               /**< Options list, one option per line */
+    char *rendered;                                 /**< The options list when rendered here, NULL when it comes from a generated parser */
+    size_t length;                                  /**< Length of the options list */
+    size_t *line_starts;                            /**< Start of every line, followed by the length of the list, "lines" + 1 entries */
+    int lines;                                      /**< Number of lines */
+    unsigned int *trigram_starts;                   /**< First entry of "trigram_lines" of every bucket, HELP_TRIGRAM_BUCKETS + 1 entries */
+    int *trigram_lines;                             /**< Lines holding the trigrams of each bucket, in order, each line once per bucket */
+};
+
+
+/**
+ * @brief Bigram index of the long names, for the "Did you mean" suggestions. Made on the first unknown option by "suggest_index_build".
+ */
+struct cmdf_suggest_index
+{
+    unsigned int mask;                              /**< Number of buckets minus one, the number of buckets is a power of two */
+    unsigned int *starts;                           /**< First entry of "options" of every bucket, buckets + 1 entries */
+    int *options;                                   /**< Index of the options whose long name holds the bigrams of each bucket, in order, each option once per bucket */
+    int *short_names;                               /**< Index of the options whose long name has up to SUGGEST_SHORT_NAME chars */
+    int short_names_len;                            /**< Number of those options */
+};
+
+
+/**
+ * @brief Values of the config file of a parser, read by "config_load". The values point into the mapped file.
+ */
+struct cmdf_config
+{
+    cmdf_args values;                               /**< Values of every line in the order of the file, and the mapped file itself */
+    int *first;                                     /**< Index in "values.argv" of the first value of every option, aliases are kept on their option */
+    int *count;                                     /**< Number of values of every option, -1 for the options not in the file */
+    int *options;                                   /**< Options named in the file, in the order they first appear */
+    int options_len;                                /**< Number of options named in the file */
+};
+
+
+/**
+ * @brief A long name to be put in the long name trie, sorted by "name_trie_entry_compare".
+ */
+typedef struct
+{
+    const char *name;                               /**< The long name */
+    size_t length;                                  /**< Length of the name */
+    int option;                                     /**< Index of the option */
+}cmdf_name_trie_entry;
+
+
+/**
+ * @brief Cursor over a bucket of the suggestion index, or over its short names list, walked by "suggest_option" in option order.
+ */
+typedef struct
+{
+    const int *options;                             /**< Options of the bucket, in increasing order */
+    unsigned int position;                          /**< Next option of the bucket */
+    unsigned int end;                               /**< Number of options of the bucket */
+    int weight;                                     /**< Bigrams counted for each option of the bucket, 0 for the short names list */
+}cmdf_suggest_cursor;
+
+
+/**
+ * @brief Id of an option, sorted by "option_id_entry_compare" to find the ids given twice.
+ */
+typedef struct
+{
+    int32_t id;                                     /**< The id */
+    int option;                                     /**< Index of the option */
+}cmdf_option_id_entry;
+
+
+/**
+ * @brief A command and the commands above it, up to the root, as selected by a command line.
+ */
+typedef struct cmdf_command_path
+{
+    const cmdf_command *command;                    /**< The command */
+    const struct cmdf_command_path *parent;         /**< The command above, NULL for the root */
+    option_parse_function parse_function;           /**< Parse function of the command, the nearest one given on the path */
+}cmdf_command_path;
+
+
+/**
+ * @brief Parser compiled for a command of a command tree. A command is known by the parser of the command above, so the
+ * same command struct listed under two commands gets a parser for each.
+ */
+typedef struct
+{
+    const cmdf_parser *parent;                      /**< Parser of the command above, NULL for the root */
+    const cmdf_command *command;                    /**< The command, NULL for an empty slot */
+    cmdf_parser *parser;                            /**< Its parser */
+}cmdf_command_entry;
+
+
+/**
+ * @brief Tree of commands and the parsers compiled for it, see "cmdf_command_tree_create".
+ * The table is written by the parses, guarded by the lock of the tree.
+ */
+struct cmdf_command_tree
+{
+    cmdf_command *root;                             /**< The program */
+    PARSER_FLAGS_Typedef flags;                     /**< Flags of every parser */
+    cmdf_command_entry *entries;                    /**< Open addressing table of the compiled parsers */
+    unsigned int mask;                              /**< Number of slots minus one, the number of slots is a power of two */
+    unsigned int entries_len;                       /**< Number of compiled parsers */
+    pthread_mutex_t lock;                           /**< Guards the table, trees don't wait on each other */
+};
+
+
+/**
+ * @brief Work shared by the threads of a batch parse.
+ */
+typedef struct
+{
+    const cmdf_parser *parser;                      /**< Parser used by every thread */
+    option_parse_function parse_function;           /**< User defined parse function */
+    cmdf_batch_item *items;                         /**< Command lines to be parsed */
+    int items_len;                                  /**< Number of command lines */
+    int next_item;                                  /**< First command line not taken by any thread yet */
+    pthread_mutex_t lock;                           /**< Guards "next_item" */
+}cmdf_batch_queue;
+
+
 /* -------------------------------------------- Private Globals -------------------------------------------------------- */
 
 /**
- * String defining the usage info when using default option --help
+ * String defining the usage info when using default option --help, copied to every parser when created
  */
 const char *cmdf_default_info_usage = NULL;
 
 
 
 /**
- * String defining the version info when using default option --version
+ * String defining the version info when using default option --version, copied to every parser when created
  */
 const char *cmdf_default_info_version = NULL;
 
 
 
 /**
- * String defining the contact info when using default option --info
+ * String defining the contact info when using default option --info, copied to every parser when created
  */
 const char *cmdf_default_info_contact_info = NULL;
 
 
 
+/**
+ * Guards the building of the caches of the parsers after their creation, the help, the trie and the suggestion index.
+ * A cache is published once with a release store, so it is read without the lock once built.
+ */
+pthread_mutex_t parser_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+
+
+
+/**
+ * The "C" locale of "convert_float", made once by the first number that needs it
+ */
+c_locale_t convert_float_locale;
+pthread_once_t convert_float_locale_once = PTHREAD_ONCE_INIT;
+
+
+
 /**
  * @brief Default options array, every option shall always have zero arguments.
  * Modify if necessary.
@@ -62,493 +503,5384 @@ const cmdf_option default_options[] =
 }; 
 
 
+#if defined(CMDF_ENABLE_STATS)
+
+/**
+ * Statistics of the parse in progress on each thread, and of the last one after it ends
+ */
+STATS_THREAD_LOCAL cmdf_stats stats_current;
+
+#endif
+
+
 /* -------------------------------------------- Private Functions ------------------------------------------------------ */
 
 
+#if defined(CMDF_ENABLE_STATS)
+
 /**
- * @brief Function to check if a character is a ascii letter.
- * @param character: Char character.
+ * @brief Monotonic time in nanoseconds, for the statistics.
  */
-int is_letter(int character)
+unsigned long long stats_now_ns(void)
 {
-    if( (character >= 'a' && character <= 'z') || (character >= 'A' && character <= 'Z') )
-        return 1;
-    else
-        return 0;
+    struct timespec now;
+
+#if defined(_WIN32)
+    timespec_get(&now, TIME_UTC);
+#else
+    clock_gettime(CLOCK_MONOTONIC, &now);
+#endif
+
+    return (unsigned long long)now.tv_sec * 1000000000ULL + (unsigned long long)now.tv_nsec;
 }
 
 
 
 /**
- * @brief Concatenates a single char into a string.
- * @param destination_string: String to receive character.
- * @param character: Char character.
+ * @brief Starts the statistics of a parse from the preparation statistics of its parser.
+ * @param parser: Parser in use.
+ */
+void stats_parse_begin(const cmdf_parser *parser)
+{
+    stats_current = parser->prepare_stats;
+    stats_current.parse_ns = stats_now_ns(); // start time, made a duration by "stats_parse_end"
+}
+
+
+
+/**
+ * @brief Ends the statistics of a parse, writing them to stderr when the environment variable CMDF_STATS is set.
  */
-void strcat_char(char *destination_string, int character)
+void stats_parse_end(void)
 {
-    char *buffer = malloc(sizeof(*buffer)+1);
+    const cmdf_stats *stats = &stats_current;
 
-    buffer[0] = (char)character;
-    buffer[1] = '\0';
+    stats_current.parse_ns = stats_now_ns() - stats_current.parse_ns;
 
-    strcat(destination_string, buffer);
+    if(getenv("CMDF_STATS") == NULL)
+        return;
 
-    free(buffer);
+    fprintf(stderr, "cmdf stats: prepare %llu ns, parse %llu ns, %llu callbacks taking %llu ns, %llu key lookups, "
+                    "%llu long name lookups with %llu probes and %llu comparisons, %llu allocations of %llu bytes\n",
+            stats->prepare_ns, stats->parse_ns, stats->callbacks, stats->callback_ns, stats->key_lookups,
+            stats->long_name_lookups, stats->long_name_probes, stats->long_name_comparisons, stats->allocations, stats->allocated_bytes);
 }
 
+#endif
+
+
 
 
 /**
- * @brief Internal error handler.
- * Called when option logic error and exceptions occur.
- * @param flags: receives flags defined by user in the main function "cdmf_parse_options" call.
- * @param format_string: Format text string jsut as in printf, also the variable arguments parameters.
+ * @brief Allocation function of the default allocator, the C library malloc.
  */
-void error_handler_parse_options_internal(PARSER_FLAGS_Typedef flags, const char* format_string, ... )
+void *default_allocator_alloc(size_t size, void *context)
 {
-    FILE *out = NULL;
-    if(flags & PARSER_FLAG_PRINT_ERRORS_STDOUT)
-        out = stdout;
-    else if(flags & PARSER_FLAG_PRINT_ERRORS_STDERR)
-        out = stderr;
-    else 
-        out = stdout; // just in case 
+    return malloc(size);
+}
 
-    va_list valist;
-    va_start(valist, format_string);
 
-    vfprintf(out, format_string, valist);
 
-    va_end(valist);
+/**
+ * @brief Reallocation function of the default allocator, the C library realloc.
+ */
+void *default_allocator_realloc(void *pointer, size_t old_size, size_t new_size, void *context)
+{
+    return realloc(pointer, new_size);
+}
+
 
-    exit(1);
 
+/**
+ * @brief Release function of the default allocator, the C library free.
+ */
+void default_allocator_free(void *pointer, void *context)
+{
+    free(pointer);
 }
 
 
 
 /**
- * @brief Default option parser.
- * @param key: Char key of defined function.
- * @param user_options: User define options array, used for printing them in --help option.
+ * @brief Default allocator, used when the user gives none.
+ */
+const cmdf_allocator default_allocator = {default_allocator_alloc, default_allocator_realloc, default_allocator_free, NULL};
+
+
+
+/**
+ * @brief Allocates a zeroed block from an allocator, like calloc.
+ * @param allocator: Allocator to be used.
+ * @param count: Number of elements.
+ * @param size: Size of each element.
+ * @return Returns the block or NULL if there is no memory.
  */
-void default_options_parser(char key, cmdf_option user_options[], PARSER_FLAGS_Typedef flags)
+void *allocator_calloc(const cmdf_allocator *allocator, size_t count, size_t size)
 {
-    int user_options_len = 0;
-    while(user_options[user_options_len].long_name != NULL)
-        user_options_len++;
+    size_t total = count * size;
+    void *block;
 
-    int i = 0;
+    if(size != 0 && total / size != count) // overflow
+        return NULL;
 
-    switch (key)
-    {
-        case __HELP_KEY:     // --help
-            i = 0;
-            if(cmdf_default_info_usage!=NULL)
-                printf("%s\n\n",cmdf_default_info_usage);
+    block = allocator->alloc((total > 0) ? total : 1, allocator->context);
 
-            if(flags | PARSER_FLAG_USE_PREDEFINED_OPTIONS) // if using default options
-            {
-                for(i = 0; i < DEFAULT_OPTIONS_LENGTH; i++) // Default options
-                {
-                    if(!(user_options[i].parameters & OPTION_HIDDEN)) // if not hidden, (OPTION_HIDDEN)
-                    {
-                        if(is_letter(user_options[i].key))
-                            printf("\t-%c ( --%s ): %s.\n", user_options[i].key, user_options[i].long_name, user_options[i].description);
-                        else
-                            printf("\t--%s : %s.\n", user_options[i].long_name, user_options[i].description);
-                    }
-                }
+    if(block != NULL)
+        memset(block, 0, total);
 
+    STATS_ADD(allocations, 1);
+    STATS_ADD(allocated_bytes, total);
 
-                while(i < user_options_len) // User defined options
-                {
-                    if(!(user_options[i].parameters & OPTION_HIDDEN)) // if not hidden, (OPTION_HIDDEN)
-                    {
-                        if(is_letter(user_options[i].key))
-                            printf("\t-%c ( --%s ): %s. Takes \"%c\" arguments.\n", user_options[i].key, user_options[i].long_name, user_options[i].description, ( (user_options[i].argq == -1) ? 'n' : (user_options[i].argq + 48) ));
-                        else
-                            printf("\t--%s : %s. Takes \"%c\" arguments.\n", user_options[i].long_name, user_options[i].description, ( (user_options[i].argq == -1) ? 'n' : (user_options[i].argq + 48) ));
-                    }
-
-                    i++;
-                }
-            }
-            else
-            {
-                while(i < user_options_len) // User defined options
-                {
-                    if(!(user_options[i].parameters & OPTION_HIDDEN)) // if not hidden, (OPTION_HIDDEN)
-                    {
-                        if(is_letter(user_options[i].key))
-                            printf("\t-%c ( --%s ): %s. Takes \"%c\" arguments.\n", user_options[i].key, user_options[i].long_name, user_options[i].description, ( (user_options[i].argq == -1) ? 'n' : (user_options[i].argq + 48) ));
-                        else
-                            printf("\t--%s : %s. Takes \"%c\" arguments.\n", user_options[i].long_name, user_options[i].description, ( (user_options[i].argq == -1) ? 'n' : (user_options[i].argq + 48) ));
-                    }
-
-                    i++;
+    return block;
+}
+
+
+
+/**
+ * @brief Releases a block given by an allocator, NULL blocks are ignored.
+ * @param allocator: Allocator that gave the block.
+ * @param pointer: Block to be released.
+ */
+void allocator_free(const cmdf_allocator *allocator, void *pointer)
+{
+    if(pointer != NULL)
+        allocator->free(pointer, allocator->context);
+}
+
+
+
+/**
+ * @brief Allocation function of the arena allocator, takes the next aligned block of the arena buffer.
+ */
+void *arena_allocator_alloc(size_t size, void *context)
+{
+    cmdf_arena *arena = (cmdf_arena*)context;
+    size_t start = (arena->used + ARENA_ALIGNMENT - 1) & ~((size_t)ARENA_ALIGNMENT - 1);
+
+    if(start > arena->size || size > arena->size - start)
+        return NULL;
+
+    arena->last = start;
+    arena->used = start + size;
+
+    return arena->buffer + start;
+}
+
+
+
+/**
+ * @brief Reallocation function of the arena allocator, grows the last block in place or moves the block to a new one.
+ */
+void *arena_allocator_realloc(void *pointer, size_t old_size, size_t new_size, void *context)
+{
+    cmdf_arena *arena = (cmdf_arena*)context;
+    void *block;
+
+    if(pointer == NULL)
+        return arena_allocator_alloc(new_size, context);
+
+    if((unsigned char*)pointer == arena->buffer + arena->last && new_size <= arena->size - arena->last) // last block, just move the end
+    {
+        arena->used = arena->last + new_size;
+        return pointer;
+    }
+
+    block = arena_allocator_alloc(new_size, context);
+
+    if(block != NULL)
+        memcpy(block, pointer, (old_size < new_size) ? old_size : new_size);
+
+    return block;
+}
+
+
+
+/**
+ * @brief Release function of the arena allocator, does nothing, the arena is released as a whole with "cmdf_arena_reset".
+ */
+void arena_allocator_free(void *pointer, void *context)
+{
+    return;
+}
+
+
+
+
+
+/**
+ * @brief Function to check if a character is a ascii letter.
+ * @param character: Char character.
+ */
+int is_letter(int character)
+{
+    if( (character >= 'a' && character <= 'z') || (character >= 'A' && character <= 'Z') )
+        return 1;
+    else
+        return 0;
+}
+
+
+
+/**
+ * @brief Internal error handler.
+ * Called when option logic error and exceptions occur. The error is recorded on the result and printed, then the program exits,
+ * unless the flag PARSER_FLAG_NOT_EXIT_ON_ERROR is set, in which case the message is printed only if a print flag is set and the parsing goes on.
+ * @param result: Result to record the error in, may be NULL.
+ * @param flags: receives flags defined by user in the main function "cdmf_parse_options" call.
+ * @param code: Error code.
+ * @param arg_index: Index on argv of the argument that caused the error, -1 if the error is not tied to an argument.
+ * @param option: Option that caused the error, NULL if there is none.
+ * @param format_string: Format text string jsut as in printf, also the variable arguments parameters.
+ */
+void error_handler_parse_options_internal(cmdf_result *result, PARSER_FLAGS_Typedef flags, PARSER_ERRORS_Typedef code, int arg_index, const cmdf_option *option, const char* format_string, ... )
+{
+    if(result != NULL)
+    {
+        if(result->error_count < CMDF_MAX_ERRORS)
+        {
+            result->errors[result->error_count].code = code;
+            result->errors[result->error_count].arg_index = arg_index;
+            result->errors[result->error_count].option = option;
+        }
+
+        result->error_count++;
+    }
+
+    FILE *out = NULL;
+    if(flags & PARSER_FLAG_PRINT_ERRORS_STDOUT)
+        out = stdout;
+    else if(flags & PARSER_FLAG_PRINT_ERRORS_STDERR)
+        out = stderr;
+    else if(!(flags & PARSER_FLAG_NOT_EXIT_ON_ERROR))
+        out = stdout; // just in case 
+
+    if(out != NULL)
+    {
+        va_list valist;
+        va_start(valist, format_string);
+
+        vfprintf(out, format_string, valist);
+
+        va_end(valist);
+    }
+
+    if(!(flags & PARSER_FLAG_NOT_EXIT_ON_ERROR))
+        exit(1);
+
+}
+
+
+
+/**
+ * @brief Appends formatted text to a text builder, growing it as needed. Once an allocation fails nothing else is appended.
+ * @param builder: Text builder, zeroed with its allocator set before the first use.
+ * @param format_string: Format text string just as in printf, also the variable arguments parameters.
+ */
+void text_builder_append(cmdf_text_builder *builder, const char *format_string, ...)
+{
+    va_list valist;
+    int length;
+
+    if(builder->failed)
+        return;
+
+    va_start(valist, format_string);
+    length = vsnprintf(builder->text + builder->length, builder->capacity - builder->length, format_string, valist);
+    va_end(valist);
+
+    if(length < 0)
+    {
+        builder->failed = 1;
+        return;
+    }
+
+    if(builder->length + (size_t)length >= builder->capacity) // didn't fit, grow and format again
+    {
+        size_t capacity = (builder->capacity > 0) ? builder->capacity : TEXT_BUILDER_INITIAL_CAPACITY;
+
+        while(builder->length + (size_t)length >= capacity)
+            capacity *= 2;
+
+        char *text = builder->allocator->realloc(builder->text, builder->capacity, capacity, builder->allocator->context);
+
+        STATS_ADD(allocations, 1);
+        STATS_ADD(allocated_bytes, capacity);
+
+        if(text == NULL)
+        {
+            builder->failed = 1;
+            return;
+        }
+
+        builder->text = text;
+        builder->capacity = capacity;
+
+        va_start(valist, format_string);
+        vsnprintf(builder->text + builder->length, builder->capacity - builder->length, format_string, valist);
+        va_end(valist);
+    }
+
+    builder->length += (size_t)length;
+}
+
+
+
+/**
+ * @brief Renders the options list of the --help option, one option per line with the names and descriptions in aligned columns.
+ * The default options are listed only with the flag PARSER_FLAG_USE_PREDEFINED_OPTIONS.
+ * @param parser: Parser with the options array.
+ * @param allocator: Allocator of the text.
+ * @param length: Receives the length of the text.
+ * @return Returns the text, NULL if there is no memory.
+ */
+char *help_render(const cmdf_parser *parser, const cmdf_allocator *allocator, size_t *length)
+{
+    const cmdf_option *options = parser->options;
+    int first = (parser->flags & PARSER_FLAG_USE_PREDEFINED_OPTIONS) ? 0 : DEFAULT_OPTIONS_LENGTH;
+    cmdf_text_builder builder = {allocator, NULL, 0, 0, 0};
+    int name_width = 0;
+    int i;
+
+    for(i = first; i < parser->options_len; i++)
+    {
+        int name_length = (int)strlen(options[i].long_name);
+
+        if(!(options[i].parameters & OPTION_HIDDEN) && name_length > name_width)
+            name_width = name_length;
+    }
+
+    text_builder_append(&builder, ""); // the text exists even without visible options
+
+    for(i = first; i < parser->options_len; i++)
+    {
+        const cmdf_option *option = &(options[i]);
+
+        if(option->parameters & OPTION_HIDDEN)
+            continue;
+
+        if(is_letter(option->key) && !(option->parameters & OPTION_NO_CHAR_KEY))
+            text_builder_append(&builder, "\t-%c, --%-*s  %s.", option->key, name_width, option->long_name, (option->description != NULL) ? option->description : "");
+        else
+            text_builder_append(&builder, "\t    --%-*s  %s.", name_width, option->long_name, (option->description != NULL) ? option->description : "");
+
+        if(i >= DEFAULT_OPTIONS_LENGTH) // default options take no arguments
+        {
+            if(option->argq == -1)
+                text_builder_append(&builder, " Takes \"n\" arguments.");
+            else
+                text_builder_append(&builder, " Takes \"%d\" arguments.", option->argq);
+        }
+
+        text_builder_append(&builder, "\n");
+    }
+
+    if(parser->command != NULL && parser->command->commands != NULL) // subcommands of a command tree
+    {
+        const cmdf_command *command;
+
+        name_width = 0;
+
+        for(command = parser->command->commands; command->name != NULL; command++)
+        {
+            if((int)strlen(command->name) > name_width)
+                name_width = (int)strlen(command->name);
+        }
+
+        text_builder_append(&builder, "\nCommands:\n");
+
+        for(command = parser->command->commands; command->name != NULL; command++)
+            text_builder_append(&builder, "\t%-*s  %s.\n", name_width, command->name, (command->description != NULL) ? command->description : "");
+    }
+
+    if(builder.failed)
+    {
+        allocator_free(allocator, builder.text);
+        return NULL;
+    }
+
+    *length = builder.length;
+    return builder.text;
+}
+
+
+
+/**
+ * @brief Bucket of the trigram starting at "text" in the help index, letters taken in lower case.
+ */
+unsigned int help_trigram_bucket(const char *text)
+{
+    unsigned int hash = ASCII_LOWER((unsigned char)text[0]);
+
+    hash = hash * 31 + ASCII_LOWER((unsigned char)text[1]);
+    hash = hash * 31 + ASCII_LOWER((unsigned char)text[2]);
+
+    return hash & (HELP_TRIGRAM_BUCKETS - 1);
+}
+
+
+
+/**
+ * @brief Releases the cached help of a parser.
+ * @param help: Cached help, may be NULL.
+ * @param allocator: Allocator that made it.
+ */
+void help_free(cmdf_help *help, const cmdf_allocator *allocator)
+{
+    if(help == NULL)
+        return;
+
+    allocator_free(allocator, help->rendered);
+    allocator_free(allocator, help->line_starts);
+    allocator_free(allocator, help->trigram_starts);
+    allocator_free(allocator, help->trigram_lines);
+    allocator_free(allocator, help);
+}
+
+
+
+/**
+ * @brief Builds the cached help of a parser: the options list, the start of each of its lines and the trigram index of the lines.
+ * Generated parsers bring the options list rendered, the other parsers render it here.
+ * @param parser: Parser with the options array.
+ * @param allocator: Allocator of the cached help.
+ * @return Returns the cached help, NULL if there is no memory.
+ */
+cmdf_help *help_build(const cmdf_parser *parser, const cmdf_allocator *allocator)
+{
+    cmdf_help *help = allocator_calloc(allocator, 1, sizeof(*help));
+    unsigned int *cursors;
+    size_t i;
+    int line;
+
+    if(help == NULL)
+        return NULL;
+
+    if(parser->help_text != NULL)
+    {
+        help->text = parser->help_text;
+        help->length = strlen(parser->help_text);
+    }
+    else
+        help->text = help->rendered = help_render(parser, allocator, &(help->length));
+
+    if(help->text == NULL)
+    {
+        help_free(help, allocator);
+        return NULL;
+    }
+
+    // every line of the options list ends with '\n'
+    for(i = 0; i < help->length; i++)
+        help->lines += (help->text[i] == '\n');
+
+    help->line_starts = allocator_calloc(allocator, (size_t)help->lines + 1, sizeof(*help->line_starts));
+    help->trigram_starts = allocator_calloc(allocator, HELP_TRIGRAM_BUCKETS + 1, sizeof(*help->trigram_starts));
+    cursors = allocator_calloc(allocator, HELP_TRIGRAM_BUCKETS, sizeof(*cursors));
+
+    if(help->line_starts == NULL || help->trigram_starts == NULL || cursors == NULL)
+    {
+        allocator_free(allocator, cursors);
+        help_free(help, allocator);
+        return NULL;
+    }
+
+    for(i = 0, line = 1; i < help->length; i++)
+    {
+        if(help->text[i] == '\n')
+            help->line_starts[line++] = i + 1;
+    }
+
+    // count the lines of each trigram, a line is counted once however many times the trigram is in it
+    for(line = 0; line < help->lines; line++)
+    {
+        for(i = help->line_starts[line]; i + 3 <= help->line_starts[line + 1] - 1; i++)
+        {
+            unsigned int bucket = help_trigram_bucket(help->text + i);
+
+            if(cursors[bucket] != (unsigned int)line + 1)
+            {
+                cursors[bucket] = (unsigned int)line + 1;
+                help->trigram_starts[bucket + 1]++;
+            }
+        }
+    }
+
+    for(i = 0; i < HELP_TRIGRAM_BUCKETS; i++)
+        help->trigram_starts[i + 1] += help->trigram_starts[i];
+
+    help->trigram_lines = allocator_calloc(allocator, help->trigram_starts[HELP_TRIGRAM_BUCKETS], sizeof(*help->trigram_lines));
+
+    if(help->trigram_lines == NULL)
+    {
+        allocator_free(allocator, cursors);
+        help_free(help, allocator);
+        return NULL;
+    }
+
+    // fill the lines of each trigram in order, the cursors now point at the next free entry of each bucket
+    memcpy(cursors, help->trigram_starts, sizeof(*cursors) * HELP_TRIGRAM_BUCKETS);
+
+    for(line = 0; line < help->lines; line++)
+    {
+        for(i = help->line_starts[line]; i + 3 <= help->line_starts[line + 1] - 1; i++)
+        {
+            unsigned int bucket = help_trigram_bucket(help->text + i);
+
+            if(cursors[bucket] == help->trigram_starts[bucket] || help->trigram_lines[cursors[bucket] - 1] != line)
+                help->trigram_lines[cursors[bucket]++] = line;
+        }
+    }
+
+    allocator_free(allocator, cursors);
+
+    return help;
+}
+
+
+
+/**
+ * @brief Gets the cached help of a parser, building it on the first call.
+ * The caches are the only part of a parser written after its creation. As parsers are shared between threads they are
+ * built under "parser_cache_lock" and published with a release store, later calls only take an acquire load.
+ * @param parser: Parser with the options array.
+ * @return Returns the cached help, NULL if there is no memory.
+ */
+const cmdf_help *help_get(const cmdf_parser *parser)
+{
+    cmdf_parser *cache_owner = (cmdf_parser*)parser;
+    cmdf_help *help = __atomic_load_n(&(cache_owner->help), __ATOMIC_ACQUIRE);
+
+    if(help != NULL)
+        return help;
+
+    pthread_mutex_lock(&parser_cache_lock);
+
+    help = cache_owner->help;
+
+    if(help == NULL) // generated parsers have no allocator and are never released, their cache lives in the heap
+    {
+        help = help_build(parser, (parser->allocator.alloc != NULL) ? &(parser->allocator) : &default_allocator);
+        __atomic_store_n(&(cache_owner->help), help, __ATOMIC_RELEASE);
+    }
+
+    pthread_mutex_unlock(&parser_cache_lock);
+
+    return help;
+}
+
+
+
+/**
+ * @brief Checks if a line of the help holds the filter, letters compared in lower case.
+ * @param line: Start of the line.
+ * @param line_end: End of the line.
+ * @param filter: Text searched.
+ * @param filter_length: Length of the filter.
+ */
+int help_line_matches(const char *line, const char *line_end, const char *filter, size_t filter_length)
+{
+    for(; line + filter_length <= line_end; line++)
+    {
+        size_t i = 0;
+
+        while(i < filter_length && ASCII_LOWER((unsigned char)line[i]) == ASCII_LOWER((unsigned char)filter[i]))
+            i++;
+
+        if(i == filter_length)
+            return 1;
+    }
+
+    return 0;
+}
+
+
+
+/**
+ * @brief Writes pieces of text to a stream, with a single system call when the stream has a file descriptor.
+ * @param out: Stream to write to, locked by the caller.
+ * @param pieces: Pieces of text.
+ * @param count: Number of pieces.
+ */
+void help_pieces_write(FILE *out, const cmdf_text_piece *pieces, int count)
+{
+    int i;
+
+#if !defined(_WIN32)
+    struct iovec vector[HELP_WRITE_PIECES];
+    int descriptor = fileno(out);
+
+    if(descriptor >= 0 && fflush(out) == 0) // what the stream holds goes first
+    {
+        int first = 0;
+
+        for(i = 0; i < count; i++)
+        {
+            vector[i].iov_base = (void*)pieces[i].text;
+            vector[i].iov_len = pieces[i].length;
+        }
+
+        // a short write leaves the rest for another call
+        while(first < count)
+        {
+            ssize_t written = writev(descriptor, vector + first, count - first);
+
+            if(written < 0)
+            {
+                if(errno == EINTR)
+                    continue;
+
+                return;
+            }
+
+            while(first < count && (size_t)written >= vector[first].iov_len)
+                written -= (ssize_t)vector[first++].iov_len;
+
+            if(first < count)
+            {
+                vector[first].iov_base = (char*)vector[first].iov_base + written;
+                vector[first].iov_len -= (size_t)written;
+            }
+        }
+
+        return;
+    }
+#endif
+
+    for(i = 0; i < count; i++)
+        fwrite(pieces[i].text, 1, pieces[i].length, out);
+}
+
+
+
+/**
+ * @brief Writes the --help output: the usage info and the options list, or only the lines of the list that hold a filter.
+ * The filtered lines come from the trigram index, only the lines holding the least common trigram of the filter are searched.
+ * @param out: Stream to write to, locked by the caller.
+ * @param parser: Parser with the options array.
+ * @param filter: Text to be found on the lines, case insensitive, NULL or empty for the whole help.
+ */
+void help_write(FILE *out, const cmdf_parser *parser, const char *filter)
+{
+    const cmdf_help *help = help_get(parser);
+    cmdf_text_piece pieces[HELP_WRITE_PIECES];
+    const int *candidates = NULL;
+    size_t filter_length = (filter != NULL) ? strlen(filter) : 0;
+    size_t i;
+    int candidates_len;
+    int count = 0;
+
+    if(help == NULL)
+        return;
+
+    if(filter_length == 0)
+    {
+        if(parser->info_usage != NULL)
+        {
+            pieces[count++] = (cmdf_text_piece){parser->info_usage, strlen(parser->info_usage)};
+            pieces[count++] = (cmdf_text_piece){"\n\n", 2};
+        }
+
+        pieces[count++] = (cmdf_text_piece){help->text, help->length};
+        help_pieces_write(out, pieces, count);
+        return;
+    }
+
+    candidates_len = help->lines; // filters shorter than a trigram search every line
+
+    if(filter_length >= 3)
+    {
+        for(i = 0; i + 3 <= filter_length; i++)
+        {
+            unsigned int bucket = help_trigram_bucket(filter + i);
+            int bucket_len = (int)(help->trigram_starts[bucket + 1] - help->trigram_starts[bucket]);
+
+            if(candidates == NULL || bucket_len < candidates_len)
+            {
+                candidates = help->trigram_lines + help->trigram_starts[bucket];
+                candidates_len = bucket_len;
+            }
+        }
+    }
+
+    for(int c = 0; c < candidates_len; c++)
+    {
+        int line = (candidates != NULL) ? candidates[c] : c;
+        const char *line_start = help->text + help->line_starts[line];
+        const char *line_end = help->text + help->line_starts[line + 1];
+
+        if(!help_line_matches(line_start, line_end - 1, filter, filter_length))
+            continue;
+
+        if(count > 0 && pieces[count - 1].text + pieces[count - 1].length == line_start) // lines in a row go out as one piece
+            pieces[count - 1].length += (size_t)(line_end - line_start);
+        else
+            pieces[count++] = (cmdf_text_piece){line_start, (size_t)(line_end - line_start)};
+
+        if(count == HELP_WRITE_PIECES)
+        {
+            help_pieces_write(out, pieces, count);
+            count = 0;
+        }
+    }
+
+    help_pieces_write(out, pieces, count);
+}
+
+
+
+/**
+ * @brief Default option parser.
+ * Writes to the parser output stream, locked for the whole option so texts from other threads don't get mixed in.
+ * @param key: Char key of defined function.
+ * @param help_filter: For --help, text the listed options must hold, as given by "--help=filter". NULL to list them all.
+ * @param parser: Parser with the options array, used for printing them in --help option, and the info strings.
+ */
+void default_options_parser(char key, const char *help_filter, const cmdf_parser *parser)
+{
+    FILE *out = (parser->output != NULL) ? parser->output : stdout; // generated parsers can't name stdout in their tables
+
+    flockfile(out);
+
+    switch (key)
+    {
+        case __HELP_KEY:     // --help
+            help_write(out, parser, help_filter);
+            break;
+
+        case __VERSION_KEY:  // --version
+            if(parser->info_version!=NULL)
+                fprintf(out, "%s\n",parser->info_version);
+            break;
+
+        case __INFO_KEY:     // --info
+            if(parser->info_contact_info!=NULL)
+                fprintf(out, "%s\n",parser->info_contact_info);
+            break;
+    }
+
+    funlockfile(out);
+
+    return;
+}
+
+
+
+/**
+ * @brief Check if key is registered.
+ * @param key: Char key to be verified.
+ * @param key_map: Key to option table made by "parse_registered_options".
+ */
+int is_option_registered(char key, cmdf_option *const key_map[KEY_MAP_LENGTH])
+{    
+    if(key_map[KEY_INDEX(key)] != NULL)
+        return 1;
+    else
+        return 0; // no key found return 0
+}
+
+
+
+/**
+ * @brief Check if an option is one of the library default options.
+ * Default options are always copied to the beginning of the options array, so a pointer comparison is enough.
+ * @param option: Option to be verified.
+ * @param options_array: Options array made by "parse_registered_options".
+ */
+int is_default_option(const cmdf_option *option, const cmdf_option *options_array)
+{
+    if(option < (options_array + DEFAULT_OPTIONS_LENGTH))
+        return 1;
+    else
+        return 0;
+}
+
+
+
+/**
+ * @brief FNV-1a hash of a string, also measures the string length on the same pass.
+ * @param string: String to be hashed.
+ * @param stop: Char that ends the string as the '\0' does, '=' for a name followed by "=value", '\0' for none.
+ * @param length: Pointer to receive the length of the string.
+ * @return Returns the 32 bit hash.
+ */
+unsigned int long_name_hash(const char *string, char stop, size_t *length)
+{
+    unsigned int hash = 2166136261u;
+    const char *cursor = string;
+
+    while(*cursor != '\0' && *cursor != stop)
+    {
+        hash ^= (unsigned char)(*cursor);
+        hash *= 16777619u;
+        cursor++;
+    }
+
+    *length = (size_t)(cursor - string);
+    return hash;
+}
+
+
+
+/**
+ * @brief Builds the long name index for an options array.
+ * When two options share a long name the first one is kept, just like the old sequential search did.
+ * @param index: Index to be filled, its tables are allocated here and released by "long_name_index_free".
+ * @param options_array: Options array to be indexed, ended by an option with a NULL long name.
+ * @param allocator: Allocator for the index tables.
+ * @return Returns 0 on success, -1 if there is no memory.
+ */
+int long_name_index_build(cmdf_long_name_index *index, cmdf_option *options_array, const cmdf_allocator *allocator)
+{
+    int i;
+    int options_len = 0;
+    unsigned int slots_len = LONG_NAME_INDEX_MIN_SLOTS;
+
+    while(options_array[options_len].long_name != NULL)
+        options_len++;
+
+    while(slots_len < (unsigned int)options_len * 2) // keep the load factor at most 0.5 so probes stay short
+        slots_len <<= 1;
+
+    index->slots = allocator_calloc(allocator, slots_len, sizeof(*index->slots));
+    index->hashes = allocator_calloc(allocator, slots_len, sizeof(*index->hashes));
+    index->lengths = allocator_calloc(allocator, slots_len, sizeof(*index->lengths));
+    index->mask = slots_len - 1;
+
+    if(index->slots == NULL || index->hashes == NULL || index->lengths == NULL)
+        return -1;
+
+    for(i = 0; i < options_len; i++)
+    {
+        size_t length;
+        unsigned int hash = long_name_hash(options_array[i].long_name, '\0', &length);
+        unsigned int slot = hash & index->mask;
+
+        while(index->slots[slot] != NULL)
+        {
+            if(index->hashes[slot] == hash && index->lengths[slot] == length && !memcmp(index->slots[slot]->long_name, options_array[i].long_name, length))
+                break; // duplicated name, keep the first one
+
+            slot = (slot + 1) & index->mask;
+        }
+
+        if(index->slots[slot] == NULL)
+        {
+            index->slots[slot] = &(options_array[i]);
+            index->hashes[slot] = hash;
+            index->lengths[slot] = length;
+        }
+    }
+
+    return 0;
+}
+
+
+
+/**
+ * @brief Releases the tables of a long name index.
+ * @param index: Index built by "long_name_index_build".
+ * @param allocator: Allocator used to build the index.
+ */
+void long_name_index_free(cmdf_long_name_index *index, const cmdf_allocator *allocator)
+{
+    allocator_free(allocator, index->slots);
+    allocator_free(allocator, index->hashes);
+    allocator_free(allocator, index->lengths);
+
+    index->slots = NULL;
+    index->hashes = NULL;
+    index->lengths = NULL;
+    index->mask = 0;
+}
+
+
+
+/**
+ * @brief Looks up the option of a long name that ends at a stop char, as the name of "--name=value", without changing the name.
+ * @param long_name: The name, ended by the stop char or by '\0'.
+ * @param stop: Char that ends the name, '\0' for none.
+ * @param name_length: Pointer to receive the length of the name.
+ * @param index: Long name index made by "parse_registered_options".
+ * @return Returns a pointer to the option struct, NULL if the name is not registered.
+ */
+cmdf_option *get_option_by_long_name_until(const char *long_name, char stop, size_t *name_length, const cmdf_long_name_index *index)
+{
+    size_t length;
+    unsigned int hash = long_name_hash(long_name, stop, &length);
+    unsigned int slot = hash & index->mask;
+
+    *name_length = length;
+
+    STATS_ADD(long_name_lookups, 1);
+
+    while(index->slots[slot] != NULL)
+    {
+        STATS_ADD(long_name_probes, 1);
+
+        if(index->hashes[slot] == hash && index->lengths[slot] == length && (STATS_ADD(long_name_comparisons, 1), !memcmp(index->slots[slot]->long_name, long_name, length)))
+            return index->slots[slot];
+
+        slot = (slot + 1) & index->mask;
+    }
+
+    return NULL;
+}
+
+
+
+/**
+ * @brief Looks up the correponding option for a given long name in the long name index.
+ * @param long_name: The full name of the options.
+ * @param index: Long name index made by "parse_registered_options".
+ * @return Returns a pointer to the option struct, NULL if the name is not registered.
+ */
+cmdf_option *get_option_by_long_name(char *long_name, const cmdf_long_name_index *index)
+{
+    size_t length;
+
+    return get_option_by_long_name_until(long_name, '\0', &length, index);
+}
+
+
+
+/**
+ * @brief Looks up the option for a given char key in the key table.
+ * @param key: The char key of the option.
+ * @param key_map: Key to option table made by "parse_registered_options".
+ * @return Returns a pointer to the option struct, NULL if the key is not registered.
+ */
+cmdf_option *get_option_by_key(char key, cmdf_option *const key_map[KEY_MAP_LENGTH])
+{
+    STATS_ADD(key_lookups, 1);
+
+    return key_map[KEY_INDEX(key)];
+}
+
+
+
+/**
+ * @brief Finds the option that an alias stands for. Aliases keep (OPTION_ALIAS) after the registration.
+ * @param options_array: Registered options.
+ * @param option: Index of the option or alias.
+ * @return Returns the index of the first option above that is not an alias, or "option" itself.
+ */
+int option_alias_head(const cmdf_option *options_array, int option)
+{
+    while(option > 0 && (options_array[option].parameters & OPTION_ALIAS))
+        option--;
+
+    return option;
+}
+
+
+
+/**
+ * @brief Order of the long name trie entries, by name and then by option so the first of two equal names comes first.
+ * @param a: First entry.
+ * @param b: Second entry.
+ * @return Returns less, equal or more than 0, as "strcmp".
+ */
+int name_trie_entry_compare(const void *a, const void *b)
+{
+    const cmdf_name_trie_entry *entry_a = a;
+    const cmdf_name_trie_entry *entry_b = b;
+    int order = strcmp(entry_a->name, entry_b->name);
+
+    if(order != 0)
+        return order;
+
+    return (entry_a->option > entry_b->option) - (entry_a->option < entry_b->option);
+}
+
+
+
+/**
+ * @brief Fills a node of the long name trie with a range of the sorted entries, and then its children.
+ * The node holds the chars that every name of the range shares after "depth", the children are reserved next to each other
+ * before any of them is filled.
+ * @param trie: Trie being built, with room for every node.
+ * @param node: Index of the node to be filled.
+ * @param options_array: Registered options.
+ * @param entries: Sorted entries whose names go through this node.
+ * @param entries_len: Number of entries, at least one.
+ * @param depth: Chars of the names already held by the nodes above.
+ * @param labels_len: Chars of "labels" already used, updated here.
+ */
+void name_trie_fill(cmdf_name_trie *trie, unsigned int node, const cmdf_option *options_array, const cmdf_name_trie_entry *entries, int entries_len, size_t depth, size_t *labels_len)
+{
+    cmdf_name_trie_node *current = &(trie->nodes[node]);
+    const cmdf_name_trie_entry *last = &(entries[entries_len - 1]);
+    size_t end = depth;
+    int first, i;
+
+    // sorted names share as many chars as the first and the last of them
+    while(end < entries[0].length && end < last->length && entries[0].name[end] == last->name[end])
+        end++;
+
+    if(node == 0)
+        end = 0; // the root holds no chars, so it always has children
+
+    current->label = (unsigned int)*labels_len;
+    current->label_length = (unsigned int)(end - depth);
+    memcpy(trie->labels + *labels_len, entries[0].name + depth, end - depth);
+    *labels_len += end - depth;
+
+    // names ending here sort first, and the first of them is the first registered
+    current->exact = (entries[0].length == end) ? entries[0].option : NAME_TRIE_NO_OPTION;
+    current->prefix = NAME_TRIE_NO_OPTION;
+
+    for(i = 0; i < entries_len; i++)
+    {
+        int option = entries[i].option;
+
+        if(options_array[option].parameters & OPTION_NO_LONG_KEY)
+            continue;
+
+        if(current->prefix == NAME_TRIE_NO_OPTION)
+            current->prefix = option;
+        else if(current->prefix != NAME_TRIE_AMBIGUOUS && option_alias_head(options_array, current->prefix) != option_alias_head(options_array, option))
+            current->prefix = NAME_TRIE_AMBIGUOUS;
+        else if(current->prefix != NAME_TRIE_AMBIGUOUS && option < current->prefix)
+            current->prefix = option; // an option and its alias, the one registered first is taken
+    }
+
+    // one child for every char that follows the shared ones
+    first = 0;
+    while(first < entries_len && entries[first].length == end)
+        first++;
+
+    current->children = trie->nodes_len;
+    current->children_len = 0;
+
+    for(i = first; i < entries_len; i++)
+    {
+        if(i == first || entries[i].name[end] != entries[i - 1].name[end])
+            current->children_len++;
+    }
+
+    trie->nodes_len += current->children_len;
+
+    for(unsigned int child = current->children; first < entries_len; child++)
+    {
+        int group_end = first + 1;
+
+        while(group_end < entries_len && entries[group_end].name[end] == entries[first].name[end])
+            group_end++;
+
+        name_trie_fill(trie, child, options_array, entries + first, group_end - first, end, labels_len);
+        first = group_end;
+    }
+}
+
+
+
+/**
+ * @brief Builds the long name trie of the registered options.
+ * @param trie: Trie to be filled, its tables are allocated here and released by "name_trie_free".
+ * @param options_array: Registered options, ended by an option with a NULL long name.
+ * @param allocator: Allocator for the trie tables.
+ * @return Returns 0 on success, -1 if there is no memory.
+ */
+int name_trie_build(cmdf_name_trie *trie, const cmdf_option *options_array, const cmdf_allocator *allocator)
+{
+    cmdf_name_trie_entry *entries;
+    size_t labels_len = 0;
+    size_t names_length = 0;
+    int options_len = 0;
+    int i;
+
+    while(options_array[options_len].long_name != NULL)
+        options_len++;
+
+    entries = allocator_calloc(allocator, options_len, sizeof(*entries));
+
+    if(entries == NULL)
+        return -1;
+
+    for(i = 0; i < options_len; i++)
+    {
+        entries[i].name = options_array[i].long_name;
+        entries[i].length = strlen(options_array[i].long_name);
+        entries[i].option = i;
+        names_length += entries[i].length;
+    }
+
+    qsort(entries, options_len, sizeof(*entries), name_trie_entry_compare);
+
+    // every node but the root ends a name or splits in two, and no char of a name is held twice
+    trie->nodes = allocator_calloc(allocator, 2 * (size_t)options_len + 1, sizeof(*trie->nodes));
+    trie->labels = allocator_calloc(allocator, names_length + 1, sizeof(*trie->labels));
+    trie->nodes_len = 1;
+
+    if(trie->nodes == NULL || trie->labels == NULL)
+    {
+        allocator_free(allocator, entries);
+        return -1;
+    }
+
+    if(options_len > 0)
+        name_trie_fill(trie, 0, options_array, entries, options_len, 0, &labels_len);
+    else
+        trie->nodes[0].exact = trie->nodes[0].prefix = NAME_TRIE_NO_OPTION;
+
+    allocator_free(allocator, entries);
+
+    return 0;
+}
+
+
+
+/**
+ * @brief Releases the tables of a long name trie.
+ * @param trie: Trie built by "name_trie_build".
+ * @param allocator: Allocator used to build the trie.
+ */
+void name_trie_free(cmdf_name_trie *trie, const cmdf_allocator *allocator)
+{
+    allocator_free(allocator, trie->nodes);
+    allocator_free(allocator, trie->labels);
+
+    trie->nodes = NULL;
+    trie->labels = NULL;
+    trie->nodes_len = 0;
+}
+
+
+
+/**
+ * @brief Finds the node of the long name trie where a name ends, a node per run of chars. Every long name starting with
+ * the name is in the subtree of that node.
+ * @param trie: Trie built by "name_trie_build".
+ * @param name: The name, without "--".
+ * @param stop: Char that ends the name as the '\0' does, '=' for a name followed by "=value", '\0' for none.
+ * @param inside: Set to 1 when the name ends before the last char of the node, so no name ends exactly there.
+ * @return Returns the index of the node, -1 if no long name starts with the name.
+ */
+int name_trie_find(const cmdf_name_trie *trie, const char *name, char stop, int *inside)
+{
+    const cmdf_name_trie_node *current = &(trie->nodes[0]);
+    const char *cursor = name;
+
+    for(;;)
+    {
+        const char *label = trie->labels + current->label;
+        unsigned int low, high;
+
+        STATS_ADD(long_name_probes, 1);
+
+        for(unsigned int i = 0; i < current->label_length; i++, cursor++)
+        {
+            if(*cursor == '\0' || *cursor == stop)
+            {
+                *inside = 1;
+                return (int)(current - trie->nodes);
+            }
+
+            if(*cursor != label[i])
+                return -1;
+        }
+
+        if(*cursor == '\0' || *cursor == stop)
+        {
+            *inside = 0;
+            return (int)(current - trie->nodes);
+        }
+
+        // children are sorted by their first char
+        low = current->children;
+        high = current->children + current->children_len;
+
+        while(low < high)
+        {
+            unsigned int middle = low + (high - low) / 2;
+            unsigned char first = (unsigned char)trie->labels[trie->nodes[middle].label];
+
+            if(first < (unsigned char)*cursor)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+
+        if(low == current->children + current->children_len || trie->labels[trie->nodes[low].label] != *cursor)
+            return -1;
+
+        current = &(trie->nodes[low]);
+    }
+}
+
+
+
+/**
+ * @brief Looks up a long name or an abbreviation of it in the long name trie.
+ * A name that is registered is always taken as it is, even when it is also the start of other names.
+ * @param trie: Trie built by "name_trie_build".
+ * @param name: The long name, without "--".
+ * @param stop: Char that ends the name as the '\0' does, see "name_trie_find".
+ * @param node: Pointer to receive the node where the name ends, where the names of an ambiguous abbreviation are.
+ * @return Returns the index of the option, NAME_TRIE_NO_OPTION or NAME_TRIE_AMBIGUOUS.
+ */
+int name_trie_lookup(const cmdf_name_trie *trie, const char *name, char stop, unsigned int *node)
+{
+    int inside;
+    int found = name_trie_find(trie, name, stop, &inside);
+    const cmdf_name_trie_node *current;
+
+    STATS_ADD(long_name_lookups, 1);
+
+    if(found < 0)
+        return NAME_TRIE_NO_OPTION;
+
+    *node = (unsigned int)found;
+    current = &(trie->nodes[found]);
+
+    if(!inside && current->exact != NAME_TRIE_NO_OPTION)
+        return current->exact;
+
+    return (name[0] != '\0' && name[0] != stop) ? current->prefix : NAME_TRIE_NO_OPTION; // "--" alone is not an abbreviation
+}
+
+
+
+/**
+ * @brief Gets the long name trie of a parser, building it on the first call when the parser takes no abbreviations.
+ * @param parser: Parser with the options array.
+ * @return Returns the trie, NULL if there is no memory.
+ */
+const cmdf_name_trie *name_trie_get(const cmdf_parser *parser)
+{
+    cmdf_parser *cache_owner = (cmdf_parser*)parser;
+    const cmdf_allocator *allocator = (parser->allocator.alloc != NULL) ? &(parser->allocator) : &default_allocator;
+    const cmdf_name_trie *trie = NULL;
+    cmdf_name_trie built = {NULL, NULL, 0};
+
+    if(__atomic_load_n(&(cache_owner->name_trie.nodes), __ATOMIC_ACQUIRE) != NULL) // published once, as the help
+        return &(cache_owner->name_trie);
+
+    pthread_mutex_lock(&parser_cache_lock);
+
+    if(cache_owner->name_trie.nodes != NULL)
+        trie = &(cache_owner->name_trie);
+    else if(name_trie_build(&built, parser->options, allocator) != 0)
+        name_trie_free(&built, allocator);
+    else
+    {
+        // the nodes go last, the readers take the trie as built once they see them
+        cache_owner->name_trie.labels = built.labels;
+        cache_owner->name_trie.nodes_len = built.nodes_len;
+        __atomic_store_n(&(cache_owner->name_trie.nodes), built.nodes, __ATOMIC_RELEASE);
+        trie = &(cache_owner->name_trie);
+    }
+
+    pthread_mutex_unlock(&parser_cache_lock);
+
+    return trie;
+}
+
+
+
+/**
+ * @brief Writes the names of an ambiguous abbreviation, one per option and its aliases, in alphabetical order.
+ * @param parser: Parser with the long name trie.
+ * @param node: Node where the abbreviation ended, from "name_trie_lookup".
+ * @param heads: Options already written, as returned by "option_alias_head", NAME_TRIE_CANDIDATES entries.
+ * @param heads_len: Number of options already written, updated here, above NAME_TRIE_CANDIDATES once the list is closed by "...".
+ * @param buffer: Receives the names, NAME_TRIE_CANDIDATES_LENGTH chars.
+ * @param used: Chars already written in the buffer, updated here.
+ */
+void name_trie_candidates(const cmdf_parser *parser, unsigned int node, int *heads, int *heads_len, char *buffer, size_t *used)
+{
+    const cmdf_name_trie_node *current = &(parser->name_trie.nodes[node]);
+
+    if(current->prefix == NAME_TRIE_NO_OPTION || *heads_len > NAME_TRIE_CANDIDATES)
+        return;
+
+    if(current->exact != NAME_TRIE_NO_OPTION && !(parser->options[current->exact].parameters & OPTION_NO_LONG_KEY))
+    {
+        int head = option_alias_head(parser->options, current->exact);
+        int i = 0;
+
+        while(i < *heads_len && heads[i] != head)
+            i++;
+
+        if(i == *heads_len)
+        {
+            size_t room = NAME_TRIE_CANDIDATES_LENGTH - sizeof(", ...") - *used; // the names always leave room for ", ..."
+            int written = -1;
+
+            if(*heads_len < NAME_TRIE_CANDIDATES)
+                written = snprintf(buffer + *used, room, "%s--%s", (*heads_len > 0) ? ", " : "", parser->options[current->exact].long_name);
+
+            if(written < 0 || (size_t)written >= room)
+            {
+                strcpy(buffer + *used, (*heads_len > 0) ? ", ..." : "...");
+                *heads_len = NAME_TRIE_CANDIDATES + 1;
+                return;
+            }
+
+            *used += (size_t)written;
+            heads[(*heads_len)++] = head;
+        }
+    }
+
+    for(unsigned int child = 0; child < current->children_len; child++)
+        name_trie_candidates(parser, current->children + child, heads, heads_len, buffer, used);
+}
+
+
+
+/**
+ * @brief Bucket of a bigram of a long name in the suggestion index. The name is taken as padded by one SUGGEST_PAD
+ * on each side, so every name of "length" chars has "length" + 1 bigrams and even the shortest names share some with their misspellings.
+ * @param name: The long name.
+ * @param length: Length of the name.
+ * @param position: Position of the bigram in the padded name, from 0 to "length".
+ * @param mask: Number of buckets minus one.
+ */
+unsigned int suggest_bigram_bucket(const char *name, size_t length, size_t position, unsigned int mask)
+{
+    unsigned int hash = 0;
+
+    for(size_t i = position; i < position + 2; i++)
+        hash = hash * 31 + ((i == 0 || i == length + 1) ? SUGGEST_PAD : (unsigned char)name[i - 1]);
+
+    return (hash * 2654435761u >> 8) & mask;
+}
+
+
+
+/**
+ * @brief Checks if an option can be suggested: its long name is used and it is not hidden.
+ */
+int suggest_is_candidate(const cmdf_option *option)
+{
+    return !(option->parameters & (OPTION_HIDDEN | OPTION_NO_LONG_KEY)) && option->long_name[0] != '\0';
+}
+
+
+
+/**
+ * @brief Releases the suggestion index of a parser.
+ * @param index: Suggestion index, may be NULL.
+ * @param allocator: Allocator that made it.
+ */
+void suggest_index_free(cmdf_suggest_index *index, const cmdf_allocator *allocator)
+{
+    if(index == NULL)
+        return;
+
+    allocator_free(allocator, index->starts);
+    allocator_free(allocator, index->options);
+    allocator_free(allocator, index->short_names);
+    allocator_free(allocator, index);
+}
+
+
+
+/**
+ * @brief Builds the suggestion index of a parser, the options holding each bigram of the long names.
+ * @param parser: Parser with the options array.
+ * @param allocator: Allocator of the index.
+ * @return Returns the index, NULL if there is no memory.
+ */
+cmdf_suggest_index *suggest_index_build(const cmdf_parser *parser, const cmdf_allocator *allocator)
+{
+    cmdf_suggest_index *index = allocator_calloc(allocator, 1, sizeof(*index));
+    unsigned int *cursors = NULL;
+    size_t bigrams = 0;
+    unsigned int buckets = SUGGEST_MIN_BUCKETS;
+    int i;
+
+    if(index == NULL)
+        return NULL;
+
+    for(i = 0; i < parser->options_len; i++)
+    {
+        if(suggest_is_candidate(&(parser->options[i])))
+        {
+            size_t length = strlen(parser->options[i].long_name);
+
+            bigrams += length + 1;
+            index->short_names_len += (length <= SUGGEST_SHORT_NAME);
+        }
+    }
+
+    while(buckets < bigrams / 4) // a few options per bucket
+        buckets *= 2;
+
+    index->mask = buckets - 1;
+    index->starts = allocator_calloc(allocator, (size_t)buckets + 1, sizeof(*index->starts));
+    index->options = allocator_calloc(allocator, bigrams, sizeof(*index->options));
+    index->short_names = allocator_calloc(allocator, (size_t)index->short_names_len, sizeof(*index->short_names));
+    cursors = allocator_calloc(allocator, buckets, sizeof(*cursors));
+
+    if(index->starts == NULL || index->options == NULL || index->short_names == NULL || cursors == NULL)
+    {
+        allocator_free(allocator, cursors);
+        suggest_index_free(index, allocator);
+        return NULL;
+    }
+
+    // count the options of each bucket, an option is counted once however many of its bigrams fall in the bucket
+    for(i = 0; i < parser->options_len; i++)
+    {
+        const char *name = parser->options[i].long_name;
+        size_t length = strlen(name);
+
+        if(!suggest_is_candidate(&(parser->options[i])))
+            continue;
+
+        for(size_t t = 0; t <= length; t++)
+        {
+            unsigned int bucket = suggest_bigram_bucket(name, length, t, index->mask);
+
+            if(cursors[bucket] != (unsigned int)i + 1)
+            {
+                cursors[bucket] = (unsigned int)i + 1;
+                index->starts[bucket + 1]++;
+            }
+        }
+    }
+
+    for(unsigned int b = 0; b < buckets; b++)
+        index->starts[b + 1] += index->starts[b];
+
+    memcpy(cursors, index->starts, sizeof(*cursors) * buckets);
+    index->short_names_len = 0;
+
+    for(i = 0; i < parser->options_len; i++)
+    {
+        const char *name = parser->options[i].long_name;
+        size_t length = strlen(name);
+
+        if(!suggest_is_candidate(&(parser->options[i])))
+            continue;
+
+        if(length <= SUGGEST_SHORT_NAME)
+            index->short_names[index->short_names_len++] = i;
+
+        for(size_t t = 0; t <= length; t++)
+        {
+            unsigned int bucket = suggest_bigram_bucket(name, length, t, index->mask);
+
+            if(cursors[bucket] == index->starts[bucket] || index->options[cursors[bucket] - 1] != i)
+                index->options[cursors[bucket]++] = i;
+        }
+    }
+
+    allocator_free(allocator, cursors);
+
+    return index;
+}
+
+
+
+/**
+ * @brief Edit distance between two strings, counting insertions, deletions, substitutions and swaps of two adjacent chars,
+ * bounded: the computation stops as soon as the distance is known to be over "bound".
+ * @param a: First string.
+ * @param a_length: Length of the first string.
+ * @param b: Second string.
+ * @param b_length: Length of the second string, at most SUGGEST_MAX_LENGTH.
+ * @param bound: Biggest distance of interest.
+ * @return Returns the distance, or "bound" + 1 when it is bigger than "bound".
+ */
+int suggest_distance(const char *a, size_t a_length, const char *b, size_t b_length, int bound)
+{
+    int rows[3][SUGGEST_MAX_LENGTH + 1];
+    int *before = rows[0], *previous = rows[1], *current = rows[2];
+    size_t i, j;
+
+    if((a_length > b_length ? a_length - b_length : b_length - a_length) > (size_t)bound)
+        return bound + 1;
+
+    for(j = 0; j <= b_length; j++)
+        previous[j] = (int)j;
+
+    for(i = 1; i <= a_length; i++)
+    {
+        int row_min;
+
+        current[0] = (int)i;
+        row_min = current[0];
+
+        for(j = 1; j <= b_length; j++)
+        {
+            int cost = (a[i - 1] != b[j - 1]);
+            int value = previous[j - 1] + cost;
+
+            if(previous[j] + 1 < value)
+                value = previous[j] + 1;
+
+            if(current[j - 1] + 1 < value)
+                value = current[j - 1] + 1;
+
+            if(i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1] && before[j - 2] + 1 < value) // swapped pair
+                value = before[j - 2] + 1;
+
+            current[j] = value;
+
+            if(value < row_min)
+                row_min = value;
+        }
+
+        if(row_min > bound) // every later row only grows
+            return bound + 1;
+
+        int *recycled = before;
+        before = previous;
+        previous = current;
+        current = recycled;
+    }
+
+    return (previous[b_length] <= bound) ? previous[b_length] : bound + 1;
+}
+
+
+
+/**
+ * @brief Gets the suggestion index of a parser, building it on the first call under "parser_cache_lock", as the help.
+ * @param parser: Parser with the options array.
+ * @return Returns the index, NULL if there is no memory.
+ */
+const cmdf_suggest_index *suggest_index_get(const cmdf_parser *parser)
+{
+    cmdf_parser *cache_owner = (cmdf_parser*)parser;
+    cmdf_suggest_index *index = __atomic_load_n(&(cache_owner->suggest_index), __ATOMIC_ACQUIRE);
+
+    if(index != NULL)
+        return index;
+
+    pthread_mutex_lock(&parser_cache_lock);
+
+    index = cache_owner->suggest_index;
+
+    if(index == NULL) // generated parsers have no allocator, as for the help cache
+    {
+        index = suggest_index_build(parser, (parser->allocator.alloc != NULL) ? &(parser->allocator) : &default_allocator);
+        __atomic_store_n(&(cache_owner->suggest_index), index, __ATOMIC_RELEASE);
+    }
+
+    pthread_mutex_unlock(&parser_cache_lock);
+
+    return index;
+}
+
+
+
+/**
+ * @brief Finds the option whose long name is the closest to a given name.
+ * Only the options sharing enough bigrams with the name to be within the maximum distance are compared, see "suggest_distance".
+ * A name within the bound is in at least "shared_min" of the buckets of the bigrams of the name, so it is in one of the
+ * shortest buckets but the "shared_min" - 1 longest: only those meet new options, the long buckets only count the bigrams
+ * of the options met. The buckets are sorted by option and are walked together a window of SUGGEST_WINDOW options at a time,
+ * so the counters stay on the stack and only the options met are cleared: a query costs the buckets of its bigrams, whatever
+ * the number of options of the parser, and takes no memory.
+ * @param parser: Parser with the options array.
+ * @param name: Name to be matched.
+ * @param length: Length of the name.
+ * @return Returns the closest option, NULL if none is within the maximum distance, SUGGEST_MAX_DISTANCE or 1 for short names.
+ */
+const cmdf_option *suggest_option(const cmdf_parser *parser, const char *name, size_t length)
+{
+    const cmdf_suggest_index *index;
+    int bound = (length <= SUGGEST_SHORT_LENGTH) ? 1 : SUGGEST_MAX_DISTANCE;
+    int shared_min;
+    const cmdf_option *best = NULL;
+    int best_distance = bound + 1;
+    int best_shared = 0;
+    cmdf_suggest_cursor buckets[SUGGEST_MAX_LENGTH + 2]; // a bucket per bigram by length, then the short names
+    int buckets_len = 0, walked_len, long_len = 0;
+    unsigned char counts[SUGGEST_WINDOW]; // 1 + the bigrams of every option of the window, 0 for the options not met
+    int met[SUGGEST_WINDOW];
+    int met_len, window;
+
+    if(length == 0 || length > SUGGEST_MAX_LENGTH || (index = suggest_index_get(parser)) == NULL)
+        return NULL;
+
+    // each edit changes at most three bigrams of the padded name (a swap of two chars does), so a name within the bound shares at least this many
+    shared_min = (int)length + 1 - 3 * bound;
+
+    for(size_t t = 0; t <= length; t++)
+    {
+        unsigned int bucket = suggest_bigram_bucket(name, length, t, index->mask);
+
+        if(index->starts[bucket] < index->starts[bucket + 1])
+            buckets[buckets_len++] = (cmdf_suggest_cursor){index->options + index->starts[bucket], 0, index->starts[bucket + 1] - index->starts[bucket], 1};
+    }
+
+    for(int i = 1; i < buckets_len; i++) // insertion sort by length, there are at most SUGGEST_MAX_LENGTH + 1
+    {
+        cmdf_suggest_cursor moved = buckets[i];
+        int j;
+
+        for(j = i; j > 0 && buckets[j - 1].end > moved.end; j--)
+            buckets[j] = buckets[j - 1];
+
+        buckets[j] = moved;
+    }
+
+    if(shared_min > 1)
+        long_len = (shared_min - 1 < buckets_len) ? shared_min - 1 : buckets_len;
+
+    walked_len = buckets_len - long_len;
+
+    // names sharing no bigram can only be within the bound when they are short, they are taken from the short names list
+    if(shared_min < 1 && index->short_names_len > 0)
+    {
+        if(walked_len < buckets_len) // the short names are walked but never searched, they go before the long buckets
+            buckets[buckets_len] = buckets[walked_len];
+
+        buckets[walked_len++] = (cmdf_suggest_cursor){index->short_names, 0, (unsigned int)index->short_names_len, 0};
+        buckets_len++;
+    }
+
+    memset(counts, 0, sizeof(counts));
+
+    while(1)
+    {
+        // the next window starts at the first option not walked yet
+        window = -1;
+
+        for(int b = 0; b < walked_len; b++)
+        {
+            if(buckets[b].position < buckets[b].end && (window < 0 || buckets[b].options[buckets[b].position] < window))
+                window = buckets[b].options[buckets[b].position];
+        }
+
+        if(window < 0)
+            break;
+
+        met_len = 0;
+
+        for(int b = 0; b < walked_len; b++)
+        {
+            cmdf_suggest_cursor *bucket = &(buckets[b]);
+
+            for(; bucket->position < bucket->end && bucket->options[bucket->position] < window + SUGGEST_WINDOW; bucket->position++)
+            {
+                int slot = bucket->options[bucket->position] - window;
+
+                if(counts[slot] == 0)
+                {
+                    met[met_len++] = slot;
+                    counts[slot] = 1;
+                }
+
+                counts[slot] += (unsigned char)bucket->weight;
+            }
+        }
+
+        // an option missing from every walked bucket is too far, the long buckets only add to the options met
+        for(int b = walked_len; b < buckets_len; b++)
+        {
+            cmdf_suggest_cursor *bucket = &(buckets[b]);
+
+            for(; bucket->position < bucket->end && bucket->options[bucket->position] < window + SUGGEST_WINDOW; bucket->position++)
+            {
+                int slot = bucket->options[bucket->position] - window;
+
+                if(slot >= 0 && counts[slot] != 0)
+                    counts[slot]++;
+            }
+        }
+
+        for(int m = 0; m < met_len; m++)
+        {
+            int candidate = window + met[m];
+            int shared = counts[met[m]] - 1;
+            // once a name is found, only the names as close as it can still be chosen
+            int needed = (int)length + 1 - 3 * ((best_distance <= bound) ? best_distance : bound);
+            const cmdf_option *option = &(parser->options[candidate]);
+            size_t option_length;
+            int distance;
+
+            counts[met[m]] = 0; // cleared for the next window
+
+            if(shared < needed)
+                continue;
+
+            option_length = strlen(option->long_name);
+
+            if(option_length > SUGGEST_MAX_LENGTH)
+                continue;
+
+            distance = suggest_distance(name, length, option->long_name, option_length, (best_distance <= bound) ? best_distance : bound);
+
+            // the closest, then the one sharing more bigrams, then the first registered
+            if(distance < best_distance || (distance == best_distance && distance <= bound &&
+               (shared > best_shared || (shared == best_shared && option < best))))
+            {
+                best = option;
+                best_distance = distance;
+                best_shared = shared;
+            }
+        }
+    }
+
+    return (best_distance <= bound) ? best : NULL;
+}
+
+
+
+/**
+ * @brief Checks if the binding of an option agrees with its number of arguments and with the size of its member.
+ * @param option: The option.
+ * @return Returns 1 for a valid binding or no binding at all, 0 otherwise.
+ */
+int binding_is_valid(const cmdf_option *option)
+{
+    const cmdf_binding *binding = &(option->binding);
+    int integer_size = (binding->size == 1 || binding->size == 2 || binding->size == 4 || binding->size == 8);
+
+    if(binding->min > binding->max)
+        return 0;
+
+    switch(binding->action)
+    {
+        case BINDING_NONE:
+            return 1;
+
+        case BINDING_SET_TRUE:
+        case BINDING_COUNT:
+            return (option->argq == 0) && integer_size;
+
+        case BINDING_STRING:
+            return (option->argq != 0) && (binding->size == sizeof(char*));
+
+        case BINDING_INT:
+        case BINDING_UINT:
+        case BINDING_SIZE:
+            return (option->argq != 0) && integer_size;
+
+        case BINDING_ENUM:
+            return (option->argq != 0) && integer_size && (binding->names != NULL);
+
+        case BINDING_FLOAT:
+            return (option->argq != 0) && (binding->size == sizeof(float) || binding->size == sizeof(double));
+
+        case BINDING_APPEND:
+            return (option->argq != 0) && (binding->size == sizeof(cmdf_list));
+
+        default:
+            return 0;
+    }
+}
+
+
+
+/**
+ * @brief Order of the option ids, by id and then by option so the first of two equal ids comes first.
+ * @param a: First entry.
+ * @param b: Second entry.
+ * @return Returns less, equal or more than 0, as "strcmp".
+ */
+int option_id_entry_compare(const void *a, const void *b)
+{
+    const cmdf_option_id_entry *entry_a = a;
+    const cmdf_option_id_entry *entry_b = b;
+
+    if(entry_a->id != entry_b->id)
+        return (entry_a->id > entry_b->id) - (entry_a->id < entry_b->id);
+
+    return (entry_a->option > entry_b->option) - (entry_a->option < entry_b->option);
+}
+
+
+
+/**
+ * @brief Checks that no two options have the same id, aliases share the id of their option. With PARSER_FLAG_WIDE_KEYS the
+ * options without a char key are not in the key table, so their ids are sorted instead, which takes thousands of options.
+ * @param parser: Parser with the options registered.
+ * @param registration_result: Result to record the ids given twice in.
+ * @return Returns 0 on success, -1 if there is no memory.
+ */
+int option_ids_check(const cmdf_parser *parser, cmdf_result *registration_result)
+{
+    cmdf_option_id_entry *entries = allocator_calloc(&(parser->allocator), parser->options_len, sizeof(*entries));
+    int entries_len = 0;
+    int i;
+
+    if(entries == NULL)
+        return -1;
+
+    for(i = 0; i < parser->options_len; i++)
+    {
+        if(!(parser->options[i].parameters & OPTION_ALIAS))
+            entries[entries_len++] = (cmdf_option_id_entry){parser->options[i].id, i};
+    }
+
+    qsort(entries, entries_len, sizeof(*entries), option_id_entry_compare);
+
+    for(i = 1; i < entries_len; i++)
+    {
+        if(entries[i].id == entries[i - 1].id)
+        {
+            const cmdf_option *option = &(parser->options[entries[i].option]);
+
+            error_handler_parse_options_internal(registration_result, parser->flags, PARSER_ERROR_DUPLICATED_KEY, -1, option, "The option --%s has the id %ld, already given to the option --%s.\n", option->long_name, (long)option->id, parser->options[entries[i - 1].option].long_name);
+        }
+    }
+
+    allocator_free(&(parser->allocator), entries);
+
+    return 0;
+}
+
+
+
+/**
+ * @brief Tweak options array, substituting aliases and duplicates, etc, and build the lookup tables used when parsing.
+ * @param user_options: User defined options array.
+ * @param flags: Parser flags to be used in error handling inside function.
+ * @param parser: Parser to receive the merged options array and its lookup tables, released with "options_table_free". Its allocator must be set.
+ * @return Returns 0 on success, -1 if there is no memory. Errors on the options are recorded on the parser.
+ */
+int parse_registered_options(cmdf_option *user_options, PARSER_FLAGS_Typedef flags, cmdf_parser *parser)
+{
+    int i;
+
+    // to check for not optional options    
+    int flag_option_was_non_alias_and_required = 0;
+
+    // to check for aliases
+    cmdf_option last_option = {0};
+
+    // registration errors are kept on the parser
+    cmdf_result *registration_result = &(parser->registration_result);
+
+
+    /* Create new array with default and user defined options to be parsed */
+
+    int options_len = 0;
+
+    while(user_options[options_len].long_name != NULL)
+        options_len++;
+
+    int total_options_length = options_len + DEFAULT_OPTIONS_LENGTH;
+
+    cmdf_option *options_array = allocator_calloc(&(parser->allocator), total_options_length+1, sizeof(cmdf_option)); // new array
+
+    if(options_array == NULL)
+        return -1;
+
+    memcpy(options_array, default_options, sizeof(cmdf_option)*DEFAULT_OPTIONS_LENGTH); // copy default options
+    memcpy((options_array + DEFAULT_OPTIONS_LENGTH), user_options, sizeof(cmdf_option)*options_len); // copy user options
+
+    options_array[total_options_length].long_name = NULL; // last element shall be empty
+
+    memset(parser->key_map, 0, sizeof(parser->key_map));
+    memset(registration_result, 0, sizeof(*registration_result));
+    parser->flags = flags;
+    parser->info_usage = cmdf_default_info_usage;
+    parser->info_version = cmdf_default_info_version;
+    parser->info_contact_info = cmdf_default_info_contact_info;
+    parser->output = stdout;
+    parser->options = options_array;
+    parser->options_len = total_options_length;
+    parser->bitset_words = BITSET_WORDS(total_options_length);
+    parser->default_mask = allocator_calloc(&(parser->allocator), parser->bitset_words, sizeof(*parser->default_mask));
+
+    if(parser->default_mask == NULL)
+        return -1;
+
+    for(i = 0; i < DEFAULT_OPTIONS_LENGTH; i++)
+        BITSET_SET(parser->default_mask, i);
+
+
+    /* One bitset for each required option, so they can be checked against the passed options a word at a time */
+
+    parser->required_len = 0;
+
+    for(i = 0; i < total_options_length; i++)
+    {
+        if(!(options_array[i].parameters & OPTION_OPTIONAL) && !(options_array[i].parameters & OPTION_ALIAS))
+            parser->required_len++;
+    }
+
+    parser->required_masks = allocator_calloc(&(parser->allocator), (size_t)parser->required_len * parser->bitset_words, sizeof(*parser->required_masks));
+    parser->required_options = allocator_calloc(&(parser->allocator), parser->required_len, sizeof(*parser->required_options));
+
+    if(parser->required_masks == NULL || parser->required_options == NULL)
+        return -1;
+
+
+
+    /* Options with an environment variable, looked up by every parse that doesn't pass them */
+
+    parser->env_options_len = 0;
+
+    for(i = 0; i < total_options_length; i++)
+    {
+        if(options_array[i].env_name != NULL)
+            parser->env_options_len++;
+    }
+
+    parser->env_options = allocator_calloc(&(parser->allocator), parser->env_options_len, sizeof(*parser->env_options));
+
+    if(parser->env_options == NULL)
+        return -1;
+
+    parser->env_options_len = 0;
+
+    for(i = 0; i < total_options_length; i++)
+    {
+        if(options_array[i].env_name != NULL)
+        {
+            parser->env_options[parser->env_options_len] = i;
+            parser->env_options_len++;
+        }
+    }
+
+
+
+    /* Run trought options, incrementing the size and substituting aliases, (OPTION_ALIAS). */
+
+    options_len = 0;
+    i = -1;
+
+    while(options_array[options_len].long_name != NULL)
+    {
+        // with PARSER_FLAG_WIDE_KEYS the options without a char key are known by their id, their key is not used
+        int wide_key = (flags & PARSER_FLAG_WIDE_KEYS) && options_len >= DEFAULT_OPTIONS_LENGTH && (options_array[options_len].parameters & OPTION_NO_CHAR_KEY);
+
+        // Duplicates
+        if(wide_key)
+            ; // checked by "option_ids_check"
+        else if(parser->key_map[KEY_INDEX(options_array[options_len].key)] == NULL) // if the key is not a DUPLICATE
+            parser->key_map[KEY_INDEX(options_array[options_len].key)] = &(options_array[options_len]);
+        else{
+            if(options_array[options_len].parameters & OPTION_NO_CHAR_KEY)
+                error_handler_parse_options_internal(registration_result, flags, PARSER_ERROR_DUPLICATED_KEY, -1, &(options_array[options_len]), "The option --%s 'key' is already registered by another option.\n", options_array[options_len].long_name);
+            else
+                error_handler_parse_options_internal(registration_result, flags, PARSER_ERROR_DUPLICATED_KEY, -1, &(options_array[options_len]), "The key -%c from option --%s is already registered by another option.\n", options_array[options_len].key, options_array[options_len].long_name);
+        }
+
+
+
+        // Key ascii check, the 0 key is reserved for floating arguments
+        if(wide_key)
+            ; // any key, 0 included
+        else if(options_array[options_len].key == 0){
+            if(options_array[options_len].parameters & OPTION_NO_CHAR_KEY)
+                error_handler_parse_options_internal(registration_result, flags, PARSER_ERROR_INVALID_KEY, -1, &(options_array[options_len]), "The option --%s have the char key set to 0, the 0 key is reserved, please change to another int or char.\n",options_array[options_len].long_name);
+            else
+                error_handler_parse_options_internal(registration_result, flags, PARSER_ERROR_INVALID_KEY, -1, &(options_array[options_len]), "The option --%s have the char key set to 0, the 0 key is reserved, please change to another int or char.\n",options_array[options_len].long_name);
+        }
+        else if( (options_array[options_len].parameters & OPTION_NO_CHAR_KEY) && is_letter(options_array[options_len].key)) // if no char key, then it must check to see if the key is a non assci letter
+            error_handler_parse_options_internal(registration_result, flags, PARSER_ERROR_INVALID_KEY, -1, &(options_array[options_len]), "An option with (OPTION_NO_CHAR_KEY) specified must be a non ascii alphabetical character. Option: -%c / --%s.\n", options_array[options_len].key, options_array[options_len].long_name);
+        else if( !(options_array[options_len].parameters & OPTION_NO_CHAR_KEY) && !is_letter(options_array[options_len].key)) // if char key, then it must check to see if the key is a asci letter
+            error_handler_parse_options_internal(registration_result, flags, PARSER_ERROR_INVALID_KEY, -1, &(options_array[options_len]), "An option with a specified char key must be a ascii alphabetical character. Option: --%s.\n", options_array[options_len].long_name);
+
+
+
+        // Number of arguments check, aliases take the number of the above option
+        if(!(options_array[options_len].parameters & OPTION_ALIAS) && options_array[options_len].argq < -1)
+            error_handler_parse_options_internal(registration_result, flags, PARSER_ERROR_INVALID_ARGQ, -1, &(options_array[options_len]), "The option --%s was registered with invalid number of argument: (%i). It should be, -1, 0 or bigger than 0.\n", options_array[options_len].long_name, options_array[options_len].argq);
+
+
+
+        // Bindings, flags and counters take no arguments and every other binding takes some, aliases take the binding of the above option
+        if(!(options_array[options_len].parameters & OPTION_ALIAS) && !binding_is_valid(&(options_array[options_len])))
+            error_handler_parse_options_internal(registration_result, flags, PARSER_ERROR_INVALID_BINDING, -1, &(options_array[options_len]), "The option --%s has a binding that doesn't agree with its number of arguments or with the size of its member.\n", options_array[options_len].long_name);
+
+
+
+        // Optional options
+        if(!(options_array[options_len].parameters & OPTION_OPTIONAL) && !(options_array[options_len].parameters & OPTION_ALIAS))    // if not optional and non alias, !(OPTION_OPTIONAL)
+        {
+            flag_option_was_non_alias_and_required = 1;
+            i++;
+            parser->required_options[i] = options_len;
+            BITSET_SET(parser->required_masks + (size_t)i * parser->bitset_words, options_len);
+        }
+        else if((options_array[options_len].parameters & OPTION_ALIAS) && flag_option_was_non_alias_and_required == 1)   // if this is a alias and last option was non optional
+        {
+            BITSET_SET(parser->required_masks + (size_t)i * parser->bitset_words, options_len);
+        }
+        else // if a new optional option appears, then stop adding aliases
+        {
+            flag_option_was_non_alias_and_required = 0;
+        }
+        
+
+
+        // Ids of the wide parse function, the char key unless given, see "cmdf_parser_parse_wide"
+        if(options_array[options_len].id < 0)
+            error_handler_parse_options_internal(registration_result, flags, PARSER_ERROR_INVALID_KEY, -1, &(options_array[options_len]), "The option --%s has the id %ld, ids must be above 0.\n", options_array[options_len].long_name, (long)options_array[options_len].id);
+        else if(options_array[options_len].id != 0)
+            ; // given by the user
+        else if(!(flags & PARSER_FLAG_WIDE_KEYS))
+            options_array[options_len].id = (unsigned char)options_array[options_len].key;
+        else if(options_array[options_len].parameters & OPTION_ALIAS)
+            options_array[options_len].id = last_option.id;
+        else if(wide_key)
+            options_array[options_len].id = CMDF_AUTO_ID(options_len - DEFAULT_OPTIONS_LENGTH);
+        else
+            options_array[options_len].id = (unsigned char)options_array[options_len].key;
+
+
+
+        // Aliases
+        if(options_array[options_len].parameters & OPTION_ALIAS) // check for aliases, (OPTION_ALIAS)
+        {
+            if(options_len == DEFAULT_OPTIONS_LENGTH) // if the first registered option is an alias, then its obvisually ilegal
+                error_handler_parse_options_internal(registration_result, flags, PARSER_ERROR_ALIAS_WITHOUT_OPTION, -1, &(options_array[options_len]), "The first option must be a non alias option, an alias must be declared below a non alias option.\n");
+
+            options_array[options_len].parameters = last_option.parameters | OPTION_ALIAS; // still known as an alias, see "option_alias_head"
+            options_array[options_len].argq = last_option.argq;
+            options_array[options_len].binding = last_option.binding;
+            options_array[options_len].description = "Alias for the above option ^^";
+        }
+        else
+        {
+            last_option = options_array[options_len];
+        }
+
+
+
+        // Environment variables give a single argument
+        if(options_array[options_len].env_name != NULL && options_array[options_len].argq > 1)
+            error_handler_parse_options_internal(registration_result, flags, PARSER_ERROR_INVALID_ARGQ, -1, &(options_array[options_len]), "The option --%s takes %i arguments, but its environment variable %s can only give one.\n", options_array[options_len].long_name, options_array[options_len].argq, options_array[options_len].env_name);
+
+
+        options_len++;
+    }
+
+    if((flags & PARSER_FLAG_WIDE_KEYS) && option_ids_check(parser, registration_result) != 0)
+        return -1;
+
+    if((flags & PARSER_FLAG_ALLOW_ABBREVIATIONS) && name_trie_build(&(parser->name_trie), options_array, &(parser->allocator)) != 0)
+        return -1;
+
+    return long_name_index_build(&(parser->long_name_index), options_array, &(parser->allocator));
+}
+
+
+
+/**
+ * @brief Releases the config file of a parser.
+ * @param config: Config to be released, may be NULL.
+ * @param allocator: Allocator that made the config.
+ */
+void config_free(cmdf_config *config, const cmdf_allocator *allocator)
+{
+    if(config == NULL)
+        return;
+
+    cmdf_args_free(&(config->values));
+    allocator_free(allocator, config->first);
+    allocator_free(allocator, config->count);
+    allocator_free(allocator, config->options);
+    allocator_free(allocator, config);
+}
+
+
+
+/**
+ * @brief Releases the constraints of a parser. Generated parsers hold them in static tables, which are left alone.
+ * @param parser: Parser whose constraints are to be released.
+ */
+void constraints_free(cmdf_parser *parser)
+{
+    if(parser->allocator.free != NULL)
+    {
+        allocator_free(&(parser->allocator), parser->constraints);
+        allocator_free(&(parser->allocator), parser->constraint_masks);
+        allocator_free(&(parser->allocator), parser->constraint_members);
+        allocator_free(&(parser->allocator), parser->aliases);
+    }
+
+    parser->constraints = NULL;
+    parser->constraints_len = 0;
+    parser->constraint_masks = NULL;
+    parser->constraint_members = NULL;
+    parser->aliases = NULL;
+    parser->aliases_len = 0;
+}
+
+
+
+/**
+ * @brief Releases everything allocated by "parse_registered_options".
+ * @param parser: Parser whose tables are to be released.
+ */
+void options_table_free(cmdf_parser *parser)
+{
+    long_name_index_free(&(parser->long_name_index), &(parser->allocator));
+    name_trie_free(&(parser->name_trie), &(parser->allocator));
+    help_free(parser->help, &(parser->allocator));
+    suggest_index_free(parser->suggest_index, &(parser->allocator));
+    allocator_free(&(parser->allocator), parser->options);
+    allocator_free(&(parser->allocator), parser->default_mask);
+    allocator_free(&(parser->allocator), parser->required_masks);
+    allocator_free(&(parser->allocator), parser->required_options);
+    allocator_free(&(parser->allocator), parser->env_options);
+    config_free(parser->config, &(parser->allocator));
+    constraints_free(parser);
+
+    parser->help = NULL;
+    parser->suggest_index = NULL;
+    parser->options = NULL;
+    parser->default_mask = NULL;
+    parser->required_masks = NULL;
+    parser->required_options = NULL;
+    parser->env_options = NULL;
+    parser->config = NULL;
+}
+
+
+
+/**
+ * @brief Check if any option of a bitset is present in another bitset, a word at a time.
+ * @param bitset: Bitset to be checked.
+ * @param mask: Bitset with the options of interest.
+ * @param words: Number of words of both bitsets.
+ */
+int bitset_intersects(const unsigned long *bitset, const unsigned long *mask, int words)
+{
+    int i;
+
+    for(i = 0; i < words; i++)
+    {
+        if(bitset[i] & mask[i])
+            return 1;
+    }
+
+    return 0;
+}
+
+
+
+/**
+ * @brief Counts the options present in two bitsets, a word at a time.
+ * @param bitset: Bitset to be checked.
+ * @param mask: Bitset with the options of interest.
+ * @param words: Number of words of both bitsets.
+ * @return Returns the number of bits set in both.
+ */
+int bitset_count_common(const unsigned long *bitset, const unsigned long *mask, int words)
+{
+    unsigned long common;
+    int i, count = 0;
+
+    for(i = 0; i < words; i++)
+    {
+        for(common = bitset[i] & mask[i]; common != 0; common &= common - 1) // clears the lowest bit set
+            count++;
+    }
+
+    return count;
+}
+
+
+
+/**
+ * @brief Appends an argument to an expanded argv, growing it when full. The argv is always kept ended by NULL.
+ * @param args: Expanded arguments.
+ * @param argument: Argument to be appended.
+ * @return Returns 0 on success, -1 if there is no memory.
+ */
+int args_append(cmdf_args *args, char *argument)
+{
+    if(args->argc + 1 >= args->argv_capacity)
+    {
+        int capacity = (args->argv_capacity > 0) ? (args->argv_capacity * 2) : ARGS_INITIAL_CAPACITY;
+        char **argv = args->allocator.realloc(args->argv, sizeof(*argv) * args->argv_capacity, sizeof(*argv) * capacity, args->allocator.context);
+
+        if(argv == NULL)
+            return -1;
+
+        args->argv = argv;
+        args->argv_capacity = capacity;
+    }
+
+    args->argv[args->argc] = argument;
+    args->argc++;
+    args->argv[args->argc] = NULL;
+
+    return 0;
+}
+
+
+
+/**
+ * @brief Loads a response file in memory, on POSIX systems the file is mapped privately so it can be tokenized in place.
+ * The loaded region always has a zero byte after the file content.
+ * @param args: Expanded arguments, receives the region to release it later.
+ * @param path: Path of the response file.
+ * @param content: Receives the start of the file content.
+ * @param content_length: Receives the length of the file content.
+ * @return Returns 0 on success, PARSER_ERROR_RESPONSE_FILE if the file can't be read or PARSER_ERROR_OUT_OF_MEMORY.
+ */
+int response_file_load(cmdf_args *args, const char *path, char **content, size_t *content_length)
+{
+    cmdf_args_mapping *mappings = (cmdf_args_mapping*)args->mappings;
+    cmdf_args_mapping mapping;
+
+    if(args->mappings_len >= args->mappings_capacity)
+    {
+        int capacity = (args->mappings_capacity > 0) ? (args->mappings_capacity * 2) : 4;
+
+        mappings = args->allocator.realloc(mappings, sizeof(*mappings) * args->mappings_capacity, sizeof(*mappings) * capacity, args->allocator.context);
+
+        if(mappings == NULL)
+            return PARSER_ERROR_OUT_OF_MEMORY;
+
+        args->mappings = mappings;
+        args->mappings_capacity = capacity;
+    }
+
+#if defined(_WIN32)
+
+    FILE *file = fopen(path, "rb");
+    long size;
+
+    if(file == NULL)
+        return PARSER_ERROR_RESPONSE_FILE;
+
+    if(fseek(file, 0, SEEK_END) != 0 || (size = ftell(file)) < 0 || fseek(file, 0, SEEK_SET) != 0)
+    {
+        fclose(file);
+        return PARSER_ERROR_RESPONSE_FILE;
+    }
+
+    mapping.length = (size_t)size + 1;
+    mapping.address = args->allocator.alloc(mapping.length, args->allocator.context);
+
+    if(mapping.address == NULL)
+    {
+        fclose(file);
+        return PARSER_ERROR_OUT_OF_MEMORY;
+    }
+
+    if(fread(mapping.address, 1, (size_t)size, file) != (size_t)size)
+    {
+        fclose(file);
+        args->allocator.free(mapping.address, args->allocator.context);
+        return PARSER_ERROR_RESPONSE_FILE;
+    }
+
+    fclose(file);
+    mapping.address[size] = '\0';
+    *content_length = (size_t)size;
+
+#else
+
+    struct stat file_info;
+    int file = open(path, O_RDONLY);
+
+    if(file < 0)
+        return PARSER_ERROR_RESPONSE_FILE;
+
+    if(fstat(file, &file_info) != 0 || !S_ISREG(file_info.st_mode))
+    {
+        close(file);
+        return PARSER_ERROR_RESPONSE_FILE;
+    }
+
+    // reserve one byte more than the file with an anonymous mapping, then place the file over it.
+    // The byte after the content is always there and zeroed, even when the file ends on a page boundary.
+    mapping.length = (size_t)file_info.st_size + 1;
+    mapping.address = mmap(NULL, mapping.length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if(mapping.address == MAP_FAILED)
+    {
+        close(file);
+        return PARSER_ERROR_OUT_OF_MEMORY;
+    }
+
+    if(file_info.st_size > 0 && mmap(mapping.address, (size_t)file_info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, file, 0) == MAP_FAILED)
+    {
+        munmap(mapping.address, mapping.length);
+        close(file);
+        return PARSER_ERROR_RESPONSE_FILE;
+    }
+
+    close(file); // the mapping stays valid without the descriptor
+    *content_length = (size_t)file_info.st_size;
+
+#endif
+
+    mappings[args->mappings_len] = mapping;
+    args->mappings_len++;
+    *content = mapping.address;
+
+    return PARSER_ERROR_NONE;
+}
+
+
+
+/**
+ * @brief Releases a region loaded by "response_file_load".
+ * @param args: Expanded arguments the region belongs to.
+ * @param mapping: Region to be released.
+ */
+void response_file_unload(cmdf_args *args, cmdf_args_mapping *mapping)
+{
+#if defined(_WIN32)
+    args->allocator.free(mapping->address, args->allocator.context);
+#else
+    munmap(mapping->address, mapping->length);
+#endif
+}
+
+
+
+int response_file_expand(cmdf_args *args, const char *path, int depth);
+
+
+
+/**
+ * @brief Checks if a char is white space, the separator of the arguments in a command string.
+ * @param c: The char.
+ * @return Returns 1 for white space, 0 otherwise.
+ */
+int is_command_space(char c)
+{
+    return (c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v');
+}
+
+
+
+/**
+ * @brief Counts the plain chars at the start of a piece of a command string, one char at a time.
+ * Plain chars are every char but white space, quotes and backslashes.
+ * @param cursor: Start of the piece.
+ * @param end: End of the piece.
+ * @return Returns the number of plain chars before the first special one, or the length of the piece if there is none.
+ */
+size_t command_scan_scalar(const char *cursor, const char *end)
+{
+    const char *start = cursor;
+
+    while(cursor < end && !is_command_space(*cursor) && *cursor != '"' && *cursor != '\'' && *cursor != '\\')
+        cursor++;
+
+    return (size_t)(cursor - start);
+}
+
+
+
+/**
+ * @brief Counts the plain chars at the start of a piece of a command string, just as "command_scan_scalar",
+ * but checking 16 chars at a time when SSE2 is available.
+ * @param cursor: Start of the piece.
+ * @param end: End of the piece.
+ * @return Returns the number of plain chars before the first special one, or the length of the piece if there is none.
+ */
+size_t command_scan_vectorized(const char *cursor, const char *end)
+{
+#if defined(COMMAND_SCAN_SSE2)
+
+    const char *start = cursor;
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i double_quote = _mm_set1_epi8('"');
+    const __m128i single_quote = _mm_set1_epi8('\'');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i control_range = _mm_set1_epi8('\r' - '\t');
+
+    while(end - cursor >= 16)
+    {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)cursor);
+        __m128i control = _mm_sub_epi8(chunk, tab);
+
+        // '\t' to '\r' are the chars whose distance to '\t' is not above the range, as unsigned bytes
+        __m128i special = _mm_cmpeq_epi8(_mm_min_epu8(control, control_range), control);
+
+        special = _mm_or_si128(special, _mm_cmpeq_epi8(chunk, space));
+        special = _mm_or_si128(special, _mm_cmpeq_epi8(chunk, double_quote));
+        special = _mm_or_si128(special, _mm_cmpeq_epi8(chunk, single_quote));
+        special = _mm_or_si128(special, _mm_cmpeq_epi8(chunk, backslash));
+
+        int mask = _mm_movemask_epi8(special);
+
+        if(mask != 0)
+            return (size_t)(cursor - start) + (size_t)__builtin_ctz((unsigned int)mask);
+
+        cursor += 16;
+    }
+
+    return (size_t)(cursor - start) + command_scan_scalar(cursor, end);
+
+#else
+
+    return command_scan_scalar(cursor, end);
+
+#endif
+}
+
+
+
+/**
+ * @brief Splits the next argument of a command string, in place.
+ * Arguments are separated by white space, single and double quotes group white space into an argument and a backslash
+ * escapes the next char, except inside single quotes where it is kept, and inside double quotes where it only escapes '"' and '\\'.
+ * Quotes and escapes are removed by moving the following chars back, and the argument is ended by writing a zero over the char
+ * that follows it, so no argument is copied. Runs of plain chars are found by "command_scan_vectorized" and moved at once.
+ * @param cursor: Position in the command string, moved past the argument.
+ * @param end: End of the command string, there must be a writable byte at "end".
+ * @param literal: Receives 1 if the argument started with a quote, 0 otherwise.
+ * @param vectorized: 1 to scan with "command_scan_vectorized", 0 to scan with "command_scan_scalar".
+ * @return Returns the argument, or NULL when the string has no more arguments.
+ */
+char *command_token_next(char **cursor, char *end, int *literal, int vectorized)
+{
+    char *current = *cursor;
+    char quote = 0;
+    size_t run;
+
+    while(current < end && is_command_space(*current))
+        current++;
+
+    if(current >= end)
+    {
+        *cursor = current;
+        return NULL;
+    }
+
+    char *token = current;
+    char *out = current; // where the next char of the token goes, never ahead of current
+
+    *literal = (*current == '"' || *current == '\'');
+
+    while(current < end)
+    {
+        if(quote == '\'')              // -------------- inside single quotes, only the closing quote matters
+        {
+            char *closing = memchr(current, '\'', (size_t)(end - current));
+
+            run = (closing != NULL) ? (size_t)(closing - current) : (size_t)(end - current);
+            memmove(out, current, run);
+            out += run;
+            current += run;
+
+            if(current < end)
+            {
+                quote = 0;
+                current++;
+            }
+
+            continue;
+        }
+
+        run = vectorized ? command_scan_vectorized(current, end) : command_scan_scalar(current, end);
+
+        if(out != current)
+            memmove(out, current, run);
+
+        out += run;
+        current += run;
+
+        if(current >= end)
+            break;
+
+        char c = *current;
+
+        if(quote == '"')                // -------------- inside double quotes, white space is kept
+        {
+            if(c == '"')
+            {
+                quote = 0;
+                current++;
+                continue;
+            }
+
+            if(c == '\\' && (current + 1) < end && (current[1] == '"' || current[1] == '\\'))
+                c = *(++current);
+        }
+        else                            // -------------- unquoted
+        {
+            if(is_command_space(c))
+                break;
+
+            if(c == '"' || c == '\'')
+            {
+                quote = c;
+                current++;
+                continue;
+            }
+
+            if(c == '\\' && (current + 1) < end)
+                c = *(++current);
+        }
+
+        *(out++) = c;
+        current++;
+    }
+
+    if(current < end)
+        current++; // jump over the separator, it may be overwritten by the end of the token
+
+    *out = '\0';
+    *cursor = current;
+
+    return token;
+}
+
+
+
+/**
+ * @brief Splits the content of a response file in arguments, in place, with "command_token_next".
+ * Unquoted arguments starting with '@' are expanded as nested response files.
+ * @param args: Expanded arguments, receives the arguments.
+ * @param text: Content of the file, with a writable byte after it.
+ * @param length: Length of the content.
+ * @param depth: Nesting depth of this file.
+ * @return Returns 0 on success or the error code.
+ */
+int response_file_tokenize(cmdf_args *args, char *text, size_t length, int depth)
+{
+    char *cursor = text;
+    char *end = text + length;
+    char *token;
+    int literal; // quoted arguments are never response files
+    int error;
+
+    while((token = command_token_next(&cursor, end, &literal, 1)) != NULL)
+    {
+        if(!literal && token[0] == '@' && token[1] != '\0')
+            error = response_file_expand(args, token + 1, depth + 1);
+        else
+            error = (args_append(args, token) == 0) ? PARSER_ERROR_NONE : PARSER_ERROR_OUT_OF_MEMORY;
+
+        if(error != PARSER_ERROR_NONE)
+            return error;
+    }
+
+    return PARSER_ERROR_NONE;
+}
+
+
+
+/**
+ * @brief Loads a response file and appends its arguments.
+ * @param args: Expanded arguments, receives the arguments.
+ * @param path: Path of the response file.
+ * @param depth: Nesting depth of the file, 1 for files named on the command line.
+ * @return Returns 0 on success or the error code, on errors "args->error_path" receives the path of the failing file.
+ */
+int response_file_expand(cmdf_args *args, const char *path, int depth)
+{
+    char *content;
+    size_t content_length;
+    int error;
+
+    if(depth > RESPONSE_FILE_MAX_DEPTH)
+        error = PARSER_ERROR_RESPONSE_FILE;
+    else
+        error = response_file_load(args, path, &content, &content_length);
+
+    if(error != PARSER_ERROR_NONE)
+    {
+        if(args->error_path == NULL)
+            args->error_path = path;
+
+        return error;
+    }
+
+    return response_file_tokenize(args, content, content_length, depth);
+}
+
+
+
+/**
+ * @brief Makes an empty config for a parser, with no option in it.
+ * @param parser: Parser the config is for.
+ * @param allocator: Allocator of the config.
+ * @return Returns the config, NULL if there is no memory.
+ */
+cmdf_config *config_create(const cmdf_parser *parser, const cmdf_allocator *allocator)
+{
+    cmdf_config *config = allocator_calloc(allocator, 1, sizeof(*config));
+    int i;
+
+    if(config == NULL)
+        return NULL;
+
+    config->values.allocator = *allocator;
+    config->first = allocator_calloc(allocator, parser->options_len, sizeof(*config->first));
+    config->count = allocator_calloc(allocator, parser->options_len, sizeof(*config->count));
+    config->options = allocator_calloc(allocator, parser->options_len, sizeof(*config->options));
+
+    if(config->first == NULL || config->count == NULL || config->options == NULL)
+    {
+        config_free(config, allocator);
+        return NULL;
+    }
+
+    for(i = 0; i < parser->options_len; i++)
+        config->count[i] = -1;
+
+    return config;
+}
+
+
+
+/**
+ * @brief Reads a config file in a single pass, every line "name = values" is split in place with "command_token_next",
+ * so its values are appended to the config argv and nothing is allocated per line.
+ * @param config: Empty config, receives the values.
+ * @param parser: Parser the config is for.
+ * @param path: Path of the config file.
+ * @param result: Result to record the errors of the lines in.
+ * @return Returns 0 when the file was read, even with errors on its lines, PARSER_ERROR_CONFIG_FILE or PARSER_ERROR_OUT_OF_MEMORY.
+ */
+int config_load(cmdf_config *config, const cmdf_parser *parser, const char *path, cmdf_result *result)
+{
+    PARSER_FLAGS_Typedef flags = parser->flags;
+    char *content, *end, *line, *line_end, *name, *name_end, *token;
+    size_t length;
+    int line_number = 0;
+    int literal, option, first;
+    int error = response_file_load(&(config->values), path, &content, &length);
+
+    if(error != PARSER_ERROR_NONE)
+        return (error == PARSER_ERROR_RESPONSE_FILE) ? PARSER_ERROR_CONFIG_FILE : error;
+
+    end = content + length;
+
+    for(line = content; line < end; line = line_end + 1)
+    {
+        line_end = memchr(line, '\n', (size_t)(end - line));
+
+        if(line_end == NULL)
+            line_end = end; // the byte after the file is writable as well
+
+        line_number++;
+
+        while(line < line_end && is_command_space(*line))
+            line++;
+
+        if(line == line_end || *line == '#' || *line == ';') // empty line or comment
+            continue;
+
+        // the name ends at white space or at '=', then the values start after the '=' if there is one
+        name = line;
+
+        while(line < line_end && !is_command_space(*line) && *line != '=')
+            line++;
+
+        name_end = line;
+
+        while(line < line_end && is_command_space(*line))
+            line++;
+
+        if(line < line_end && *line == '=')
+            line++;
+
+        *name_end = '\0';
+
+        cmdf_option *current_option = get_option_by_long_name(name, &(parser->long_name_index));
+
+        if(current_option == NULL || is_default_option(current_option, parser->options)) // default options are never read from a file
+        {
+            if(flags & PARSER_FLAG_DONT_IGNORE_NON_REGISTERED_OPTIONS)
+                error_handler_parse_options_internal(result, flags, PARSER_ERROR_INVALID_OPTION, -1, NULL, "The option %s on line %d of the config file %s is invalid!\n", name, line_number, path);
+
+            continue; // ignore if the error handler above doesn't exit the program
+        }
+
+        option = option_alias_head(parser->options, (int)(current_option - parser->options));
+        first = config->values.argc;
+
+        while((token = command_token_next(&line, line_end, &literal, 1)) != NULL)
+        {
+            if(args_append(&(config->values), token) != 0)
+                return PARSER_ERROR_OUT_OF_MEMORY;
+        }
+
+        if(parser->options[option].argq == 0 && config->values.argc > first)
+        {
+            error_handler_parse_options_internal(result, flags, PARSER_ERROR_TOO_MANY_ARGUMENTS, -1, &(parser->options[option]), "The option --%s on line %d of the config file %s takes no arguments.\n", parser->options[option].long_name, line_number, path);
+            continue; // ignore if the error handler above doesn't exit the program
+        }
+
+        if(config->count[option] < 0)
+        {
+            config->options[config->options_len] = option;
+            config->options_len++;
+        }
+
+        config->first[option] = first; // a later line replaces the values of an earlier one
+        config->count[option] = config->values.argc - first;
+    }
+
+    return PARSER_ERROR_NONE;
+}
+
+
+
+/**
+ * @brief Compiles the constraints of "cmdf_parser_set_constraints" into the tables of a parser, one bitset per constraint.
+ * Every name is looked up in the long name index and an alias stands for the option above it, so the bitsets only hold options.
+ * @param parser: Parser with no constraints, receives them.
+ * @param constraints: Constraints, ended by an empty one.
+ * @param allocator: Allocator of the tables.
+ * @param result: Result to record the invalid constraints in, which are left out.
+ * @return Returns 0 on success, -1 if there is no memory.
+ */
+int constraints_compile(cmdf_parser *parser, const cmdf_constraint *constraints, const cmdf_allocator *allocator, cmdf_result *result)
+{
+    const char *name;
+    size_t name_length;
+    unsigned long *mask;
+    cmdf_constraint_check *check;
+    int constraints_len = 0, names_len = 0, members_len = 0;
+    int i, option, word, first_name;
+
+    for(i = 0; constraints[i].kind != CONSTRAINT_NONE; i++)
+    {
+        constraints_len++;
+
+        for(name = constraints[i].options; name != NULL && *name != '\0'; name++)
+        {
+            if(*name != ' ' && (name == constraints[i].options || name[-1] == ' ')) // first char of a name
+                names_len++;
+        }
+    }
+
+    for(i = 0; i < parser->options_len; i++)
+    {
+        if(parser->options[i].parameters & OPTION_ALIAS)
+            parser->aliases_len++;
+    }
+
+    parser->constraints = allocator_calloc(allocator, constraints_len, sizeof(*parser->constraints));
+    parser->constraint_masks = allocator_calloc(allocator, (size_t)constraints_len * parser->bitset_words, sizeof(*parser->constraint_masks));
+    parser->constraint_members = allocator_calloc(allocator, names_len, sizeof(*parser->constraint_members));
+    parser->aliases = allocator_calloc(allocator, parser->aliases_len, sizeof(*parser->aliases));
+
+    if(parser->constraints == NULL || parser->constraint_masks == NULL || parser->constraint_members == NULL || parser->aliases == NULL)
+        return -1;
+
+    parser->aliases_len = 0;
+
+    for(i = 0; i < parser->options_len; i++)
+    {
+        if(parser->options[i].parameters & OPTION_ALIAS)
+            parser->aliases[parser->aliases_len++] = i;
+    }
+
+    for(i = 0; constraints[i].kind != CONSTRAINT_NONE; i++)
+    {
+        int subject_kind = (constraints[i].kind == CONSTRAINT_REQUIRES || constraints[i].kind == CONSTRAINT_CONFLICTS);
+
+        check = &(parser->constraints[parser->constraints_len]);
+        mask = parser->constraint_masks + (size_t)parser->constraints_len * parser->bitset_words;
+        check->kind = constraints[i].kind;
+        check->subject = -1;
+        check->members = members_len;
+        check->members_len = 0;
+        first_name = 1;
+
+        if(constraints[i].kind > CONSTRAINT_CONFLICTS || constraints[i].options == NULL)
+        {
+            error_handler_parse_options_internal(result, parser->flags, PARSER_ERROR_INVALID_CONSTRAINT, -1, NULL, "The constraint %d has an unknown kind or no options.\n", i);
+            continue; // ignore if the error handler above doesn't exit the program
+        }
+
+        for(name = constraints[i].options; *name != '\0'; name += name_length)
+        {
+            if(*name == ' ')
+            {
+                name_length = 1;
+                continue;
+            }
+
+            cmdf_option *current_option = get_option_by_long_name_until(name, ' ', &name_length, &(parser->long_name_index));
+
+            if(current_option == NULL)
+            {
+                error_handler_parse_options_internal(result, parser->flags, PARSER_ERROR_INVALID_CONSTRAINT, -1, NULL, "The constraint \"%s\" names the option --%.*s, which is not registered.\n", constraints[i].options, (int)name_length, name);
+                check->kind = CONSTRAINT_NONE;
+                break;
+            }
+
+            option = option_alias_head(parser->options, (int)(current_option - parser->options));
+
+            if(subject_kind && first_name)
+                check->subject = option;
+            else if(option != check->subject && !BITSET_TEST(mask, option)) // an option named twice counts once
+            {
+                BITSET_SET(mask, option);
+                parser->constraint_members[members_len++] = option;
+                check->members_len++;
+            }
+
+            first_name = 0;
+        }
+
+        if(check->kind == CONSTRAINT_NONE) // unknown option, reported above
+        {
+            memset(mask, 0, sizeof(*mask) * parser->bitset_words);
+            members_len = check->members;
+            continue;
+        }
+
+        if(check->members_len < ((check->kind == CONSTRAINT_EXCLUSIVE) ? 2 : 1))
+        {
+            error_handler_parse_options_internal(result, parser->flags, PARSER_ERROR_INVALID_CONSTRAINT, -1, NULL, "The constraint \"%s\" names too few options.\n", constraints[i].options);
+            memset(mask, 0, sizeof(*mask) * parser->bitset_words);
+            members_len = check->members;
+            continue;
+        }
+
+        // the options of a constraint are usually close together, so only the words between the first and the last are checked
+        check->first_word = parser->bitset_words;
+        check->words = 0;
+
+        for(word = 0; word < parser->bitset_words; word++)
+        {
+            if(mask[word] == 0)
+                continue;
+
+            if(check->first_word > word)
+                check->first_word = word;
+
+            check->words = word - check->first_word + 1;
+        }
+
+        parser->constraints_len++;
+    }
+
+    return 0;
+}
+
+
+
+/**
+ * @brief Reads an unsigned integer, in decimal or in hexadecimal after "0x", without the C locale.
+ * @param text: Text to be read.
+ * @param value: Receives the value.
+ * @param end: Receives the first char after the number.
+ * @return Returns 1 on success, 0 if there are no digits or the value doesn't fit in 64 bits.
+ */
+int convert_unsigned(const char *text, unsigned long long *value, const char **end)
+{
+    unsigned long long result = 0;
+    unsigned int base = 10;
+    unsigned int digit;
+    const char *start;
+
+    if(text[0] == '0' && (text[1] == 'x' || text[1] == 'X'))
+    {
+        base = 16;
+        text += 2;
+    }
+
+    start = text;
+
+    while(1)
+    {
+        if(*text >= '0' && *text <= '9')
+            digit = (unsigned int)(*text - '0');
+        else if(base == 16 && *text >= 'a' && *text <= 'f')
+            digit = (unsigned int)(*text - 'a' + 10);
+        else if(base == 16 && *text >= 'A' && *text <= 'F')
+            digit = (unsigned int)(*text - 'A' + 10);
+        else
+            break;
+
+        if(result > (ULLONG_MAX - digit) / base) // overflow
+            return 0;
+
+        result = result * base + digit;
+        text++;
+    }
+
+    *value = result;
+    *end = text;
+
+    return (text != start);
+}
+
+
+
+/**
+ * @brief Makes the "C" locale of "convert_float", called once.
+ */
+void convert_float_locale_create(void)
+{
+    convert_float_locale = c_locale_new();
+}
+
+
+
+/**
+ * @brief Reads a float or double without the C locale, the decimal point is always '.'.
+ * Numbers with up to 19 significant digits and a power of ten up to 22 are exact doubles and are computed directly,
+ * the others go to strtod in the "C" locale, made once and never changed, so it is safe from any thread.
+ * @param text: Text to be read, the whole text must be the number.
+ * @param value: Receives the value.
+ * @return Returns 1 on success, 0 if the text is not a number.
+ */
+int convert_float(const char *text, double *value)
+{
+    static const double powers_of_ten[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                           1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    const char *cursor = text;
+    unsigned long long mantissa = 0;
+    int significant_digits = 0, digits = 0, exponent = 0, negative = 0;
+
+    if(*cursor == '-' || *cursor == '+')
+        negative = (*(cursor++) == '-');
+
+    for(; *cursor >= '0' && *cursor <= '9'; cursor++, digits++)
+    {
+        if(significant_digits < 19)
+        {
+            mantissa = mantissa * 10 + (unsigned long long)(*cursor - '0');
+            significant_digits += (mantissa != 0);
+        }
+        else
+            exponent++; // digits that don't fit only scale the value
+    }
+
+    if(*cursor == '.')
+    {
+        for(cursor++; *cursor >= '0' && *cursor <= '9'; cursor++, digits++)
+        {
+            if(significant_digits < 19)
+            {
+                mantissa = mantissa * 10 + (unsigned long long)(*cursor - '0');
+                significant_digits += (mantissa != 0);
+                exponent--;
+            }
+        }
+    }
+
+    if(digits == 0)
+        return 0;
+
+    if(*cursor == 'e' || *cursor == 'E')
+    {
+        int exponent_negative = 0, exponent_value = 0;
+
+        cursor++;
+
+        if(*cursor == '-' || *cursor == '+')
+            exponent_negative = (*(cursor++) == '-');
+
+        if(*cursor < '0' || *cursor > '9')
+            return 0;
+
+        for(; *cursor >= '0' && *cursor <= '9'; cursor++)
+        {
+            if(exponent_value < 100000)
+                exponent_value = exponent_value * 10 + (*cursor - '0');
+        }
+
+        exponent += exponent_negative ? -exponent_value : exponent_value;
+    }
+
+    if(*cursor != '\0')
+        return 0;
+
+    if(mantissa <= (1ULL << 53) && exponent >= -22 && exponent <= 22) // both the mantissa and the power are exact doubles
+    {
+        double result = (double)mantissa;
+
+        result = (exponent < 0) ? (result / powers_of_ten[-exponent]) : (result * powers_of_ten[exponent]);
+        *value = negative ? -result : result;
+
+        return 1;
+    }
+
+    // the rare remaining numbers go to strtod in the "C" locale, the text is already known to be a plain number
+    char *end;
+
+    pthread_once(&convert_float_locale_once, convert_float_locale_create);
+
+    if(convert_float_locale == (c_locale_t)0)
+        return 0; // no locale, the number is refused rather than read with the locale of the process
+
+    errno = 0;
+
+#if defined(_WIN32)
+    *value = _strtod_l(text, &end, convert_float_locale);
+#else
+    c_locale_t previous = uselocale(convert_float_locale); // only changes the locale of this thread
+
+    *value = strtod(text, &end);
+    uselocale(previous);
+#endif
+
+    return (*end == '\0') && !(errno == ERANGE && (*value == HUGE_VAL || *value == -HUGE_VAL)); // overflows are not numbers, underflows are 0
+}
+
+
+
+/**
+ * @brief Reads a size, an unsigned integer with an optional suffix k, M, G or T, in any case, for powers of 1024,
+ * optionally followed by "B" or "iB".
+ * @param text: Text to be read, the whole text must be the size.
+ * @param value: Receives the size in bytes.
+ * @return Returns 1 on success, 0 if the text is not a size or it doesn't fit in 64 bits.
+ */
+int convert_size(const char *text, unsigned long long *value)
+{
+    const char *end;
+    unsigned long long result;
+    int shift = 0;
+
+    if(!convert_unsigned(text, &result, &end))
+        return 0;
+
+    switch(*end)
+    {
+        case 'k': case 'K': shift = 10; break;
+        case 'm': case 'M': shift = 20; break;
+        case 'g': case 'G': shift = 30; break;
+        case 't': case 'T': shift = 40; break;
+        default: break;
+    }
+
+    if(shift != 0)
+    {
+        end++;
+
+        if(*end == 'i' && end[1] == 'B')
+            end++;
+    }
+
+    if(*end == 'B')
+        end++;
+
+    if(*end != '\0' || (result > (ULLONG_MAX >> shift)))
+        return 0;
+
+    *value = result << shift;
+
+    return 1;
+}
+
+
+
+/**
+ * @brief Writes an integer on a member of 1, 2, 4 or 8 bytes, truncated to the member size.
+ * @param field: The member.
+ * @param size: Size of the member.
+ * @param value: Value to be written.
+ */
+void binding_store_integer(void *field, size_t size, unsigned long long value)
+{
+    uint8_t value_8 = (uint8_t)value;
+    uint16_t value_16 = (uint16_t)value;
+    uint32_t value_32 = (uint32_t)value;
+    uint64_t value_64 = (uint64_t)value;
+
+    switch(size)
+    {
+        case 1: memcpy(field, &value_8, 1); break;
+        case 2: memcpy(field, &value_16, 2); break;
+        case 4: memcpy(field, &value_32, 4); break;
+        default: memcpy(field, &value_64, 8); break;
+    }
+}
+
+
+
+/**
+ * @brief Reads an integer member of 1, 2, 4 or 8 bytes, as unsigned.
+ * @param field: The member.
+ * @param size: Size of the member.
+ * @return Returns the value.
+ */
+unsigned long long binding_load_integer(const void *field, size_t size)
+{
+    uint8_t value_8;
+    uint16_t value_16;
+    uint32_t value_32;
+    uint64_t value_64;
+
+    switch(size)
+    {
+        case 1: memcpy(&value_8, field, 1); return value_8;
+        case 2: memcpy(&value_16, field, 2); return value_16;
+        case 4: memcpy(&value_32, field, 4); return value_32;
+        default: memcpy(&value_64, field, 8); return value_64;
+    }
+}
+
+
+
+/**
+ * @brief Writes an argument straight into the member an option is bound to, converting it to the member type.
+ * @param option: Option with a binding.
+ * @param extern_user_variables_struct: User struct holding the member.
+ * @param argument: The argument, NULL for options without arguments.
+ * @return Returns 0 on success, PARSER_ERROR_INVALID_VALUE if the argument can't be converted or is out of range, or
+ * PARSER_ERROR_TOO_MANY_ARGUMENTS if a list is full.
+ */
+int binding_apply(const cmdf_option *option, void *extern_user_variables_struct, char *argument)
+{
+    const cmdf_binding *binding = &(option->binding);
+    char *field = (char*)extern_user_variables_struct + binding->offset;
+    int bits = (int)(binding->size * CHAR_BIT);
+    unsigned long long magnitude;
+    const char *end;
+    double real;
+    int i;
+
+    switch(binding->action)
+    {
+        case BINDING_SET_TRUE:
+            binding_store_integer(field, binding->size, 1);
+            break;
+
+        case BINDING_COUNT:
+            binding_store_integer(field, binding->size, binding_load_integer(field, binding->size) + 1);
+            break;
+
+        case BINDING_STRING:
+            memcpy(field, &argument, sizeof(argument));
+            break;
+
+        case BINDING_INT:
+        {
+            int negative = (argument[0] == '-');
+            long long min = (binding->min != 0 || binding->max != 0) ? binding->min : (bits >= 64 ? LLONG_MIN : -(1LL << (bits - 1)));
+            long long max = (binding->min != 0 || binding->max != 0) ? binding->max : (bits >= 64 ? LLONG_MAX : (1LL << (bits - 1)) - 1);
+            long long value;
+
+            if(!convert_unsigned(argument + (negative || argument[0] == '+'), &magnitude, &end) || *end != '\0')
+                return PARSER_ERROR_INVALID_VALUE;
+
+            if(negative ? (magnitude > (unsigned long long)LLONG_MAX + 1) : (magnitude > (unsigned long long)LLONG_MAX))
+                return PARSER_ERROR_INVALID_VALUE;
+
+            value = negative ? (long long)(0 - magnitude) : (long long)magnitude;
+
+            if(value < min || value > max)
+                return PARSER_ERROR_INVALID_VALUE;
+
+            binding_store_integer(field, binding->size, (unsigned long long)value);
+            break;
+        }
+
+        case BINDING_UINT:
+        case BINDING_SIZE:
+        {
+            unsigned long long min = (binding->min != 0 || binding->max != 0) ? (unsigned long long)binding->min : 0;
+            unsigned long long max = (binding->min != 0 || binding->max != 0) ? (unsigned long long)binding->max : (bits >= 64 ? ULLONG_MAX : (1ULL << bits) - 1);
+
+            if(binding->action == BINDING_SIZE)
+            {
+                if(!convert_size(argument, &magnitude))
+                    return PARSER_ERROR_INVALID_VALUE;
+            }
+            else if(!convert_unsigned(argument, &magnitude, &end) || *end != '\0')
+                return PARSER_ERROR_INVALID_VALUE;
+
+            if(binding->min < 0 || magnitude < min || magnitude > max)
+                return PARSER_ERROR_INVALID_VALUE;
+
+            binding_store_integer(field, binding->size, magnitude);
+            break;
+        }
+
+        case BINDING_FLOAT:
+            if(!convert_float(argument, &real))
+                return PARSER_ERROR_INVALID_VALUE;
+
+            if(binding->size == sizeof(float))
+            {
+                if(real > FLT_MAX || real < -FLT_MAX)
+                    return PARSER_ERROR_INVALID_VALUE;
+
+                float single = (float)real;
+                memcpy(field, &single, sizeof(single));
+            }
+            else
+                memcpy(field, &real, sizeof(real));
+
+            break;
+
+        case BINDING_ENUM:
+            for(i = 0; binding->names[i] != NULL; i++)
+            {
+                if(!strcmp(argument, binding->names[i]))
+                    break;
+            }
+
+            if(binding->names[i] == NULL)
+                return PARSER_ERROR_INVALID_VALUE;
+
+            binding_store_integer(field, binding->size, (unsigned long long)i);
+            break;
+
+        case BINDING_APPEND:
+        {
+            cmdf_list *list = (cmdf_list*)field;
+
+            if(list->len >= list->capacity)
+                return PARSER_ERROR_TOO_MANY_ARGUMENTS;
+
+            list->items[list->len] = argument;
+            list->len++;
+            break;
+        }
+
+        default:
+            break;
+    }
+
+    return PARSER_ERROR_NONE;
+}
+
+
+
+/**
+ * @brief Applies the binding of an option, reporting the argument when it can't be written.
+ * @param state: Parse in progress.
+ * @param option: Option with a binding.
+ * @param argument: The argument, NULL for options without arguments.
+ * @param argument_index: Index of the argument, for the error report.
+ */
+void option_parser_bind(cmdf_parse_state *state, const cmdf_option *option, char *argument, int argument_index)
+{
+    int error = binding_apply(option, state->extern_user_variables_struct, argument);
+
+    if(error == PARSER_ERROR_INVALID_VALUE)
+        error_handler_parse_options_internal(state->result, state->parser->flags, PARSER_ERROR_INVALID_VALUE, argument_index, option, "The value \"%s\" is not valid for the option --%s.\n", argument, option->long_name);
+    else if(error == PARSER_ERROR_TOO_MANY_ARGUMENTS)
+        error_handler_parse_options_internal(state->result, state->parser->flags, PARSER_ERROR_TOO_MANY_ARGUMENTS, argument_index, option, "The option --%s can't take more than %d arguments.\n", option->long_name, ((cmdf_list*)((char*)state->extern_user_variables_struct + option->binding.offset))->capacity);
+}
+
+
+
+/**
+ * @brief Starts a parse.
+ * @param state: State to be started.
+ * @param parser: Parser in use.
+ * @param parse_function: User defined parse function.
+ * @param extern_user_variables_struct: Pointer to user defined struct.
+ * @param result: Result to record errors in, already holding the registration errors.
+ * @param options_passed_bitset: Bitset of "parser->bitset_words" words, cleared here.
+ * @param first_index: Index given to the first argument pushed.
+ */
+void parse_state_begin(cmdf_parse_state *state, const cmdf_parser *parser, option_parse_function parse_function, void *extern_user_variables_struct, cmdf_result *result, unsigned long *options_passed_bitset, int first_index)
+{
+    state->parser = parser;
+    state->parse_function = parse_function;
+    state->view_function = NULL;
+    state->wide_function = NULL;
+    state->extern_user_variables_struct = extern_user_variables_struct;
+    state->result = result;
+    state->options_passed_bitset = options_passed_bitset;
+    state->pending_option = NULL;
+    state->pending_index = 0;
+    state->pending_count = 0;
+    state->argument_index = first_index;
+    state->argv = NULL;
+    state->span_start = 0;
+    state->span_count = 0;
+
+    memset(options_passed_bitset, 0, sizeof(*options_passed_bitset) * parser->bitset_words);
+
+#if defined(CMDF_ENABLE_STATS)
+    stats_parse_begin(parser);
+#endif
+}
+
+
+
+/**
+ * @brief Refuses the parses that would give the options of a parser with PARSER_FLAG_WIDE_KEYS to a function taking char keys,
+ * its long only options have none and would come as floating arguments.
+ * @param parser: Parser in use.
+ * @param char_keys: Set when the parse has a parse or view function.
+ * @param result: Result of the parse, receives the error.
+ * @return Returns PARSER_ERROR_WIDE_KEYS when the parse is refused, 0 otherwise.
+ */
+int parse_wide_keys_check(const cmdf_parser *parser, int char_keys, cmdf_result *result)
+{
+    if(!(parser->flags & PARSER_FLAG_WIDE_KEYS) || (!char_keys && parser->span_function == NULL))
+        return 0;
+
+    error_handler_parse_options_internal(result, parser->flags, PARSER_ERROR_WIDE_KEYS, -1, NULL, "The options of a parser with PARSER_FLAG_WIDE_KEYS have no char key, parse it with cmdf_parser_parse_wide and no span function.\n");
+
+    return PARSER_ERROR_WIDE_KEYS;
+}
+
+
+
+/**
+ * @brief Calls the user parse function, the view function with the argument measured once here, or the wide parse function with the id
+ * of the option, timing it when the statistics are enabled. Nothing is called when the parse has none.
+ * @param state: Parse in progress.
+ * @param option: The option, NULL for floating arguments, which go with the key and the id 0.
+ * @param argument: Argument, NULL for options without arguments.
+ * @param argument_index: Index of the argument.
+ */
+void parse_function_call(cmdf_parse_state *state, const cmdf_option *option, char *argument, int argument_index)
+{
+    char key = (option != NULL) ? option->key : 0;
+
+    if(state->parse_function == NULL && state->view_function == NULL && state->wide_function == NULL)
+        return;
+
+    STATS_TIME_BEGIN(start);
+
+    if(state->view_function != NULL)
+    {
+        cmdf_view view = {argument, (argument != NULL) ? strlen(argument) : 0};
+
+        state->view_function(key, view, argument_index, state->extern_user_variables_struct);
+    }
+    else if(state->wide_function != NULL)
+        state->wide_function((option != NULL) ? option->id : 0, argument, argument_index, state->extern_user_variables_struct);
+    else
+        state->parse_function(key, argument, argument_index, state->extern_user_variables_struct);
+
+    STATS_ADD(callbacks, 1);
+    STATS_TIME_END(callback_ns, start);
+}
+
+
+
+/**
+ * @brief Gives the run of arguments of the pending option gathered so far to the span function, timing it when the statistics are enabled.
+ * @param state: Parse in progress, with a pending option.
+ * @param arguments: The arguments.
+ * @param count: Number of arguments, nothing is called for 0.
+ */
+void span_function_call(cmdf_parse_state *state, char **arguments, int count)
+{
+    if(count == 0)
+        return;
+
+    STATS_TIME_BEGIN(start);
+
+    state->parser->span_function(state->pending_option->key, arguments, count, state->extern_user_variables_struct);
+
+    STATS_ADD(callbacks, 1);
+    STATS_TIME_END(callback_ns, start);
+}
+
+
+
+/**
+ * @brief Checks if the arguments of the pending option go to the span function, that is not for bound or default options.
+ * @param state: Parse in progress.
+ * @return Returns 1 if they do, 0 otherwise or without a pending option.
+ */
+int option_parser_spans(const cmdf_parse_state *state)
+{
+    const cmdf_option *current_option = state->pending_option;
+
+    return (current_option != NULL && state->parser->span_function != NULL && current_option->binding.action == BINDING_NONE && !is_default_option(current_option, state->parser->options));
+}
+
+
+
+/**
+ * @brief Adds an argument of the pending option to its run, the run is given to the span function when the option ends.
+ * Arguments that are not the next one of an argv end the run so far and are given alone.
+ * @param state: Parse in progress, with a pending option.
+ * @param argument: Argument of the option.
+ * @param argument_index: Index of the argument, -1 for arguments not on the command line.
+ */
+void option_parser_span(cmdf_parse_state *state, char *argument, int argument_index)
+{
+    if(state->argv != NULL && argument_index >= 0 && state->argv[argument_index] == argument) // in argv, right after the run
+    {
+        if(state->span_count == 0)
+            state->span_start = argument_index;
+
+        state->span_count++;
+        return;
+    }
+
+    span_function_call(state, state->argv + state->span_start, state->span_count);
+    state->span_count = 0;
+
+    span_function_call(state, &argument, 1);
+}
+
+
+
+/**
+ * @brief Receives an option, options without arguments are dispatched at once, the others wait for their arguments.
+ * @param state: Parse in progress.
+ * @param current_option: Struct with the current option information.
+ * @param option_index: Argument index of the option.
+ */
+void option_parser_begin(cmdf_parse_state *state, cmdf_option *current_option, int option_index)
+{
+    if(current_option->argq == 0)       // -------------- take no arguments
+    {
+        if(current_option->binding.action != BINDING_NONE)                 // bound option, no user call
+            option_parser_bind(state, current_option, NULL, option_index);
+        else if(is_default_option(current_option, state->parser->options)) // default option
+            default_options_parser(current_option->key, NULL, state->parser);
+        else                                                                // user option
+            parse_function_call(state, current_option, NULL, 0); // call with NULL on argument;
+
+        return;
+    }
+
+    // -------------- take "n" arguments, or as many arguments as possible when argq is -1
+    state->pending_option = current_option;
+    state->pending_index = option_index;
+    state->pending_count = 0;
+}
+
+
+
+/**
+ * @brief Calls the user define option parser function upon an argument of the pending option.
+ * @param state: Parse in progress, with a pending option.
+ * @param argument: Argument of the option.
+ * @param argument_index: Index of the argument.
+ */
+void option_parser_argument(cmdf_parse_state *state, char *argument, int argument_index)
+{
+    cmdf_option *current_option = state->pending_option;
+
+    if(current_option->binding.action != BINDING_NONE)                     // bound option, written straight into the user struct
+        option_parser_bind(state, current_option, argument, argument_index);
+    else if(is_default_option(current_option, state->parser->options))     // default option
+        default_options_parser(current_option->key, NULL, state->parser);
+    else if(state->parser->span_function != NULL)                           // arguments given in runs, see "option_parser_spans"
+        option_parser_span(state, argument, argument_index);
+    else
+        parse_function_call(state, current_option, argument, state->pending_count);
+
+    state->pending_count++; // each new argument to the option has a index given by the counter
+}
+
+
+
+/**
+ * @brief Ends the pending option, when another option comes or the arguments end, checking the number of arguments it took.
+ * @param state: Parse in progress.
+ */
+void option_parser_end(cmdf_parse_state *state)
+{
+    cmdf_option *current_option = state->pending_option;
+    PARSER_FLAGS_Typedef flags = state->parser->flags;
+    cmdf_result *result = state->result;
+    int option_index = state->pending_index;
+    int arg_counter = state->pending_count;
+
+    if(current_option == NULL)
+        return;
+
+    if(state->span_count > 0)
+    {
+        span_function_call(state, state->argv + state->span_start, state->span_count);
+        state->span_count = 0;
+    }
+
+    state->pending_option = NULL;
+
+    if(current_option->argq == -1)
+    {
+        if(arg_counter == 0) // and option was given after the current one, or nothing at all
+        {
+            if(current_option->parameters & OPTION_NO_CHAR_KEY)
+                error_handler_parse_options_internal(result, flags, PARSER_ERROR_MISSING_ARGUMENTS, option_index, current_option, "The option --%s needs at least one valid argument.\n", current_option->long_name);
+            else
+                error_handler_parse_options_internal(result, flags, PARSER_ERROR_MISSING_ARGUMENTS, option_index, current_option, "The option -%c / --%s needs at least one valid argument.\n", current_option->key, current_option->long_name);
+        }
+    }
+    else if(arg_counter > current_option->argq)
+    {
+        if(current_option->parameters & OPTION_NO_CHAR_KEY)
+            error_handler_parse_options_internal(result, flags, PARSER_ERROR_TOO_MANY_ARGUMENTS, option_index, current_option, "The option --%s has too many arguments, it only receives \"%i\" many.\n", current_option->long_name,current_option->argq);
+        else
+            error_handler_parse_options_internal(result, flags, PARSER_ERROR_TOO_MANY_ARGUMENTS, option_index, current_option, "The option -%c / --%s has too many arguments, it only receives \"%i\" many.\n",current_option->key,current_option->long_name,current_option->argq);
+    }
+    else if(arg_counter < current_option->argq)
+    {
+        if(current_option->parameters & OPTION_NO_CHAR_KEY)
+            error_handler_parse_options_internal(result, flags, PARSER_ERROR_TOO_FEW_ARGUMENTS, option_index, current_option, "The option --%s has too few arguments, it expects at least \"%i\".\n",current_option->long_name,current_option->argq);
+        else
+            error_handler_parse_options_internal(result, flags, PARSER_ERROR_TOO_FEW_ARGUMENTS, option_index, current_option, "The option -%c / --%s has too few arguments, it expects at least \"%i\".\n",current_option->key,current_option->long_name,current_option->argq);
+    }
+
+}
+
+
+
+/**
+ * @brief Receives an option with its first argument in the same argument of the command line, as in "--name=value" or "-ovalue".
+ * The value points into the argument, which is never changed. The option may still take the next arguments, as if they were separated.
+ * @param state: Parse in progress, without a pending option.
+ * @param current_option: Struct with the current option information.
+ * @param value: The attached value, up to the end of the argument.
+ * @param option_index: Argument index of the option, also the index of the value.
+ */
+void option_parser_attached(cmdf_parse_state *state, cmdf_option *current_option, char *value, int option_index)
+{
+    if(current_option->argq != 0)
+    {
+        option_parser_begin(state, current_option, option_index);
+        option_parser_argument(state, value, option_index);
+        return;
+    }
+
+    if(is_default_option(current_option, state->parser->options) && current_option->key == __HELP_KEY) // "--help=filter", only the options holding the filter are listed
+        default_options_parser(__HELP_KEY, value, state->parser);
+    else if(current_option->parameters & OPTION_NO_CHAR_KEY)
+        error_handler_parse_options_internal(state->result, state->parser->flags, PARSER_ERROR_TOO_MANY_ARGUMENTS, option_index, current_option, "The option --%s takes no arguments, but was given \"%s\".\n", current_option->long_name, value);
+    else
+        error_handler_parse_options_internal(state->result, state->parser->flags, PARSER_ERROR_TOO_MANY_ARGUMENTS, option_index, current_option, "The option -%c / --%s takes no arguments, but was given \"%s\".\n", current_option->key, current_option->long_name, value);
+}
+
+
+
+/**
+ * @brief Parses the next argument of the command line.
+ * The argument only has to be valid during this call, unless the user parse function keeps it.
+ * @param state: Parse in progress.
+ * @param current_argument: The argument.
+ */
+void parse_state_push(cmdf_parse_state *state, char *current_argument)
+{
+    const cmdf_parser *parser = state->parser;
+    PARSER_FLAGS_Typedef flags = parser->flags;
+    cmdf_result *result = state->result;
+    cmdf_option *current_option = NULL;
+    int i = state->argument_index;
+    int j = 0;
+
+    state->argument_index++;
+
+    if(current_argument[0] != '-')                                          // ------------- argument
+    {
+        if(state->pending_option != NULL)
+            option_parser_argument(state, current_argument, i);
+        else
+            parse_function_call(state, NULL, current_argument, i); // pass alone argument with the 0 key
+
+        return;
+    }
+
+    option_parser_end(state); // another option came, the pending one takes no more arguments
+
+    if(current_argument[1]=='-')                                            // ------------- long name option
+    {
+
+        size_t name_length;
+
+        current_argument += 2; // remove the "--" in the beginning
+        current_option = get_option_by_long_name_until(current_argument, '=', &name_length, &(parser->long_name_index)); // the name ends at "=value"
+
+        if(current_option == NULL && (flags & PARSER_FLAG_ALLOW_ABBREVIATIONS)) // whole names are faster in the hash index, the trie takes the rest
+        {
+            unsigned int node;
+            int option = name_trie_lookup(&(parser->name_trie), current_argument, '=', &node);
+
+            if(option == NAME_TRIE_AMBIGUOUS)
+            {
+                char candidates[NAME_TRIE_CANDIDATES_LENGTH] = "";
+                int heads[NAME_TRIE_CANDIDATES];
+                int heads_len = 0;
+                size_t used = 0;
+
+                name_trie_candidates(parser, node, heads, &heads_len, candidates, &used);
+                error_handler_parse_options_internal(result, flags, PARSER_ERROR_AMBIGUOUS_OPTION, i, NULL, "The option --%.*s is ambiguous! It could be %s.\n", (int)name_length, current_argument, (candidates[0] != '\0') ? candidates : "more than one option");
+
+                return; // ignore if the error handler above doesn't exit the program
+            }
+
+            current_option = (option >= 0) ? &(parser->options[option]) : NULL;
+        }
+
+        if(current_option == NULL) // option is not registered
+        {
+            if (flags & PARSER_FLAG_DONT_IGNORE_NON_REGISTERED_OPTIONS)
+            {
+                const cmdf_option *suggestion = suggest_option(parser, current_argument, name_length);
+
+                if(suggestion != NULL)
+                    error_handler_parse_options_internal(result, flags, PARSER_ERROR_INVALID_OPTION, i, NULL, "The option --%.*s is invalid! Did you mean --%s?\n", (int)name_length, current_argument, suggestion->long_name);
+                else
+                    error_handler_parse_options_internal(result, flags, PARSER_ERROR_INVALID_OPTION, i, NULL, "The option --%.*s is invalid!\n", (int)name_length, current_argument);
+            }
+
+            return; // ignore if the error handler above doesn't exit the program
+        }
+
+        BITSET_SET(state->options_passed_bitset, current_option - parser->options); // remember option
+
+        if(current_option->parameters & OPTION_NO_LONG_KEY) // long name of the option is not to be used
+            return;
+
+        if(current_argument[name_length] == '=') // "--name=value"
+            option_parser_attached(state, current_option, current_argument + name_length + 1, i);
+        else
+            option_parser_begin(state, current_option, i);
+
+    }
+    else                                                                    // ------------- char key option
+    {
+
+        current_argument += 1; // jump over the "-" 
+
+        int nested = (current_argument[0] != '\0' && current_argument[1] != '\0'); // more than one key in a single "-"
+
+        j = 0;
+        while(current_argument[j] != '\0') // for every letter in option
+        {
+            current_option = get_option_by_key(current_argument[j], parser->key_map);
+
+            if(current_option == NULL) // option is not registered
+            {
+                if (flags & PARSER_FLAG_DONT_IGNORE_NON_REGISTERED_OPTIONS)
+                {
+                    // a long name written with a single '-', or a key in the wrong case
+                    const cmdf_option *suggestion = nested ? suggest_option(parser, current_argument, strlen(current_argument)) : NULL;
+                    const cmdf_option *other_case = get_option_by_key((char)(ASCII_LOWER(current_argument[j]) != current_argument[j] ? ASCII_LOWER(current_argument[j]) : current_argument[j] - ('a' - 'A')), parser->key_map);
+
+                    if(suggestion != NULL)
+                        error_handler_parse_options_internal(result, flags, PARSER_ERROR_INVALID_OPTION, i, NULL, "The option -%s is invalid! Did you mean --%s?\n", current_argument, suggestion->long_name);
+                    else if(is_letter(current_argument[j]) && other_case != NULL && !(other_case->parameters & OPTION_NO_CHAR_KEY))
+                        error_handler_parse_options_internal(result, flags, PARSER_ERROR_INVALID_OPTION, i, NULL, "The option -%s is invalid! Did you mean -%c?\n", current_argument, other_case->key);
+                    else
+                        error_handler_parse_options_internal(result, flags, PARSER_ERROR_INVALID_OPTION, i, NULL, "The option -%s is invalid!\n", current_argument);
+                }
+
+                j++;
+                continue; // ignore if the error handler above doesn't exit the program
+            }
+
+            if(j == 0 && nested && current_option->argq != 0) // "-ovalue", the rest of the argument is the first argument of the option
+            {
+                BITSET_SET(state->options_passed_bitset, current_option - parser->options); // remember option
+
+                option_parser_attached(state, current_option, current_argument + 1, i);
+                return;
+            }
+
+            if( nested && (current_option->argq != 0) ) // check for when nested options come, trown an error if one of then requires an argument. only no argument options can be nested.
+            {
+                error_handler_parse_options_internal(result, flags, PARSER_ERROR_NESTED_OPTION, i, current_option, "Only nested options can be nested in a single \"-\". Nested options passed: -%s , Option that requires arguments: -%c.\n",current_argument,current_option->key);
+
+                j++;
+                continue; // skip the option if the error handler above doesn't exit the program
+            }
+
+            BITSET_SET(state->options_passed_bitset, current_option - parser->options); // remember option
+
+            option_parser_begin(state, current_option, i);
+
+            j++;
+        }
+
+    }
+}
+
+
+
+/**
+ * @brief Checks if an option or any of its aliases was given.
+ * @param state: Parse in progress.
+ * @param option: Index of the option, not of an alias.
+ * @return Returns 1 if it was given, 0 otherwise.
+ */
+int parse_state_option_given(const cmdf_parse_state *state, int option)
+{
+    const cmdf_parser *parser = state->parser;
+    int i = option;
+
+    do
+    {
+        if(BITSET_TEST(state->options_passed_bitset, i))
+            return 1;
+
+        i++;
+    }
+    while(i < parser->options_len && (parser->options[i].parameters & OPTION_ALIAS));
+
+    return 0;
+}
+
+
+
+/**
+ * @brief Gives an option its values from the environment or from the config file, as if it came after the command line.
+ * @param state: Parse in progress, without a pending option.
+ * @param option: Index of the option.
+ * @param values: The values.
+ * @param values_len: Number of values, 0 for options without arguments.
+ */
+void parse_state_layer(cmdf_parse_state *state, int option, char **values, int values_len)
+{
+    cmdf_option *current_option = &(state->parser->options[option]);
+    int i;
+
+    BITSET_SET(state->options_passed_bitset, option); // counts for the required options
+
+    option_parser_begin(state, current_option, -1);
+
+    if(current_option->argq == 0)
+        return;
+
+    if(state->parser->span_function != NULL && current_option->binding.action == BINDING_NONE) // the values are already next to each other
+    {
+        span_function_call(state, values, values_len);
+        state->pending_count = values_len;
+    }
+    else
+    {
+        for(i = 0; i < values_len; i++)
+            option_parser_argument(state, values[i], -1);
+    }
+
+    option_parser_end(state);
+}
+
+
+
+/**
+ * @brief Gives the options missing from the command line their environment variable, or else their values in the config file.
+ * @param state: Parse in progress, without a pending option.
+ */
+void parse_state_layers(cmdf_parse_state *state)
+{
+    const cmdf_parser *parser = state->parser;
+    const cmdf_config *config = parser->config;
+    char *value;
+    int i, option;
+
+    for(i = 0; i < parser->env_options_len; i++)
+    {
+        option = parser->env_options[i];
+
+        if(parse_state_option_given(state, option_alias_head(parser->options, option)))
+            continue;
+
+        value = getenv(parser->options[option].env_name);
+
+        if(value == NULL)
+            continue;
+
+        if(parser->options[option].argq == 0 && (value[0] == '\0' || !strcmp(value, "0"))) // a flag set to nothing or to 0 is not given
+            continue;
+
+        parse_state_layer(state, option, &value, 1);
+    }
+
+    if(config == NULL)
+        return;
+
+    for(i = 0; i < config->options_len; i++)
+    {
+        option = config->options[i];
+
+        if(!parse_state_option_given(state, option))
+            parse_state_layer(state, option, config->values.argv + config->first[option], config->count[option]);
+    }
+}
+
+
+
+/**
+ * @brief Takes at once the arguments of an argv that follow the pending option, up to the next option, when they go to the span function.
+ * They are only counted, so a long run costs a single scan for the next '-'.
+ * @param state: Parse in progress, parsing "argv" with the argument indexes of argv.
+ * @param argc: Number of arguments in argv.
+ * @return Returns the number of arguments taken.
+ */
+int parse_state_take_run(cmdf_parse_state *state, int argc)
+{
+    char **argv = state->argv;
+    int start = state->argument_index;
+    int end = start;
+
+    if(!option_parser_spans(state))
+        return 0;
+
+    while(end < argc && argv[end][0] != '-')
+        end++;
+
+    if(state->span_count == 0)
+        state->span_start = start;
+
+    state->span_count += end - start;
+    state->pending_count += end - start;
+    state->argument_index = end;
+
+    return end - start;
+}
+
+
+
+/**
+ * @brief Lists the long names of some options of a constraint as "--a, --b or --c", cut if they don't fit.
+ * @param parser: Parser with the constraints.
+ * @param members: Options of the constraint.
+ * @param members_len: Number of options.
+ * @param buffer: Receives the list, CONSTRAINT_NAMES_LENGTH chars.
+ * @return Returns the buffer.
+ */
+const char *constraint_names(const cmdf_parser *parser, const int *members, int members_len, char *buffer)
+{
+    size_t used = 0;
+    int i;
+
+    buffer[0] = '\0';
+
+    for(i = 0; i < members_len && used < CONSTRAINT_NAMES_LENGTH; i++)
+    {
+        const char *separator = (i == 0) ? "" : (i == members_len - 1) ? " or " : ", ";
+        int written = snprintf(buffer + used, CONSTRAINT_NAMES_LENGTH - used, "%s--%s", separator, parser->options[members[i]].long_name);
+
+        if(written < 0)
+            break;
+
+        used += (size_t)written;
+    }
+
+    return buffer;
+}
+
+
+
+/**
+ * @brief Checks the constraints of a parser against the options given, an alias counts as the option above it.
+ * Each constraint costs a few operations per word of its bitset between its first and its last option, however many options it names.
+ * @param state: Parse in progress, with every option given.
+ */
+void parse_state_constraints(cmdf_parse_state *state)
+{
+    const cmdf_parser *parser = state->parser;
+    unsigned long *given = state->options_passed_bitset;
+    char names[CONSTRAINT_NAMES_LENGTH];
+    int i, j, count, first, second;
+
+    for(i = 0; i < parser->aliases_len; i++) // the bitset is not used after this, so the aliases are moved to their options in place
+    {
+        if(BITSET_TEST(given, parser->aliases[i]))
+            BITSET_SET(given, option_alias_head(parser->options, parser->aliases[i]));
+    }
+
+    for(i = 0; i < parser->constraints_len; i++)
+    {
+        const cmdf_constraint_check *check = &(parser->constraints[i]);
+        const unsigned long *mask = parser->constraint_masks + (size_t)i * parser->bitset_words;
+        const int *members = parser->constraint_members + check->members;
+
+        if(check->subject >= 0 && !BITSET_TEST(given, check->subject))
+            continue; // the constraint is only about its subject
+
+        count = bitset_count_common(given + check->first_word, mask + check->first_word, check->words);
+
+        if(check->kind == CONSTRAINT_REQUIRES && count == check->members_len)
+            continue;
+
+        if(((check->kind == CONSTRAINT_EXCLUSIVE || check->kind == CONSTRAINT_EXACTLY_ONE) && count > 1) || (check->kind == CONSTRAINT_CONFLICTS && count > 0))
+        {
+            // name the first two options given, or the subject and the first option given
+            first = check->subject;
+            second = -1;
+
+            for(j = 0; j < check->members_len && second < 0; j++)
+            {
+                if(!BITSET_TEST(given, members[j]))
+                    continue;
+
+                if(first < 0)
+                    first = members[j];
+                else
+                    second = members[j];
+            }
+
+            if(check->kind == CONSTRAINT_CONFLICTS)
+                error_handler_parse_options_internal(state->result, parser->flags, PARSER_ERROR_CONSTRAINT, -1, &(parser->options[first]), "The option --%s can't be given with the option --%s.\n", parser->options[first].long_name, parser->options[second].long_name);
+            else
+                error_handler_parse_options_internal(state->result, parser->flags, PARSER_ERROR_CONSTRAINT, -1, &(parser->options[first]), "The options --%s and --%s can't be given together.\n", parser->options[first].long_name, parser->options[second].long_name);
+        }
+        else if((check->kind == CONSTRAINT_AT_LEAST_ONE || check->kind == CONSTRAINT_EXACTLY_ONE) && count == 0)
+        {
+            error_handler_parse_options_internal(state->result, parser->flags, PARSER_ERROR_CONSTRAINT, -1, &(parser->options[members[0]]), "One of the options %s needs to be specified.\n", constraint_names(parser, members, check->members_len, names));
+        }
+        else if(check->kind == CONSTRAINT_REQUIRES)
+        {
+            for(j = 0; BITSET_TEST(given, members[j]); j++) // one of them is missing
+                ;
+
+            error_handler_parse_options_internal(state->result, parser->flags, PARSER_ERROR_CONSTRAINT, -1, &(parser->options[check->subject]), "The option --%s needs the option --%s.\n", parser->options[check->subject].long_name, parser->options[members[j]].long_name);
+        }
+    }
+}
+
+
+
+/**
+ * @brief Ends a parse, ending the pending option and checking for the required options and the constraints.
+ * @param state: Parse in progress.
+ * @return Returns the code of the first error found, 0 if none.
+ */
+int parse_state_end(cmdf_parse_state *state)
+{
+    const cmdf_parser *parser = state->parser;
+    cmdf_result *result = state->result;
+    int i;
+
+    option_parser_end(state);
+
+    // check for required options if no default option was called
+    if(!bitset_intersects(state->options_passed_bitset, parser->default_mask, parser->bitset_words))
+    {
+        if(parser->env_options_len > 0 || parser->config != NULL) // argv goes over the environment, which goes over the config file
+            parse_state_layers(state);
+
+        for(i = 0; i < parser->required_len; i++)
+        {
+            if(!bitset_intersects(state->options_passed_bitset, parser->required_masks + (size_t)i * parser->bitset_words, parser->bitset_words)) // neither the option nor its aliases were passed
+            {
+                cmdf_option *required_option = &(parser->options[parser->required_options[i]]);
+
+                if(required_option->parameters & OPTION_NO_CHAR_KEY)
+                    error_handler_parse_options_internal(result, parser->flags, PARSER_ERROR_REQUIRED_OPTION, -1, required_option, "The --%s option needs to be specified.\n", required_option->long_name);
+                else
+                    error_handler_parse_options_internal(result, parser->flags, PARSER_ERROR_REQUIRED_OPTION, -1, required_option, "The option -%c / --%s needs to be specified.\n",required_option->key,required_option->long_name);
+            }
+        }
+
+        if(parser->constraints_len > 0)
+            parse_state_constraints(state);
+    }
+
+#if defined(CMDF_ENABLE_STATS)
+    stats_parse_end();
+#endif
+
+    if(result->error_count > 0)
+        return result->errors[0].code;
+    else
+        return PARSER_ERROR_NONE;
+}
+
+
+
+/**
+ * @brief Reads a stream of delimited arguments and parses each one as soon as it is complete.
+ * Only the bytes of the buffer are used, an argument that doesn't fit in it is reported and skipped.
+ * @param state: Parse in progress.
+ * @param file_descriptor: Stream to read from, until its end.
+ * @param delimiter: Char that ends every argument.
+ * @param buffer: Buffer for the arguments being read.
+ * @param buffer_size: Size of the buffer.
+ */
+void stream_parse(cmdf_parse_state *state, int file_descriptor, char delimiter, char *buffer, size_t buffer_size)
+{
+    PARSER_FLAGS_Typedef flags = state->parser->flags;
+    size_t filled = 0;      // bytes in the buffer
+    size_t scanned = 0;     // bytes already searched for a delimiter
+    int skipping = 0;       // dropping the rest of an argument that was too long
+    ssize_t bytes_read;
+
+    while(1)
+    {
+        bytes_read = read(file_descriptor, buffer + filled, buffer_size - filled);
+
+        if(bytes_read < 0)
+        {
+            if(errno == EINTR)
+                continue;
+
+            error_handler_parse_options_internal(state->result, flags, PARSER_ERROR_STREAM_READ, state->argument_index, NULL, "The arguments stream could not be read.\n");
+            return;
+        }
+
+        if(bytes_read == 0) // end of the stream, the last argument may not have a delimiter
+            break;
+
+        filled += (size_t)bytes_read;
+
+        char *argument = buffer; // start of the argument not parsed yet
+        char *delimiter_position;
+
+        while((delimiter_position = memchr(buffer + scanned, delimiter, filled - scanned)) != NULL)
+        {
+            scanned = (size_t)(delimiter_position - buffer) + 1;
+            *delimiter_position = '\0';
+
+            if(delimiter == '\n' && delimiter_position > argument && delimiter_position[-1] == '\r')
+                delimiter_position[-1] = '\0';
+
+            if(skipping)
+                skipping = 0;
+            else if(argument[0] != '\0') // empty arguments, as blank lines, are skipped
+                parse_state_push(state, argument);
+
+            argument = buffer + scanned;
+        }
+
+        // move the incomplete argument to the start of the buffer, to be completed by the next read
+        filled -= (size_t)(argument - buffer);
+        memmove(buffer, argument, filled);
+        scanned = filled;
+
+        if(filled == buffer_size)
+        {
+            if(!skipping)
+                error_handler_parse_options_internal(state->result, flags, PARSER_ERROR_ARGUMENT_TOO_LONG, state->argument_index, NULL, "An argument of the stream is longer than %zu bytes.\n", buffer_size - 1);
+
+            state->argument_index += !skipping;
+            skipping = 1;
+            filled = 0;
+            scanned = 0;
+        }
+    }
+
+    if(filled > 0 && !skipping)
+    {
+        buffer[filled] = '\0'; // there is room, the buffer is never full here
+
+        if(delimiter == '\n' && buffer[filled - 1] == '\r')
+            buffer[filled - 1] = '\0';
+
+        if(buffer[0] != '\0')
+            parse_state_push(state, buffer);
+    }
+}
+
+
+
+/**
+ * @brief Finds a subcommand by name.
+ * @param command: Command with subcommands.
+ * @param name: Name given on the command line.
+ * @return Returns the subcommand, NULL if none has this name.
+ */
+const cmdf_command *command_find(const cmdf_command *command, const char *name)
+{
+    for(const cmdf_command *subcommand = command->commands; subcommand->name != NULL; subcommand++)
+    {
+        if(!strcmp(subcommand->name, name))
+            return subcommand;
+    }
+
+    return NULL;
+}
+
+
+
+/**
+ * @brief Slot of a command in the compiled commands table of a tree.
+ */
+unsigned int command_tree_slot(const cmdf_parser *parent, const cmdf_command *command, unsigned int mask)
+{
+    unsigned long long key = (unsigned long long)(uintptr_t)command ^ ((unsigned long long)(uintptr_t)parent * 0x9E3779B97F4A7C15ULL);
+
+    return (unsigned int)((key * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+}
+
+
+
+/**
+ * @brief Compiles the parser of a command, with the options of every command on its path, the root ones first.
+ * The options of the commands above keep the same index as in their parsers, so their passed options carry over.
+ * @param tree: Tree of the command.
+ * @param path: The command and the commands above.
+ * @return Returns the parser, NULL if there is no memory.
+ */
+cmdf_parser *command_parser_create(const cmdf_command_tree *tree, const cmdf_command_path *path)
+{
+    const cmdf_command_path *step;
+    cmdf_option *options;
+    cmdf_parser *parser;
+    int options_len = 0;
+    int end;
+
+    for(step = path; step != NULL; step = step->parent)
+    {
+        for(int i = 0; step->command->options != NULL && step->command->options[i].long_name != NULL; i++)
+            options_len++;
+    }
+
+    options = allocator_calloc(&default_allocator, options_len + 1, sizeof(*options)); // ended by an empty option
+
+    if(options == NULL)
+        return NULL;
+
+    end = options_len;
+
+    for(step = path; step != NULL; step = step->parent) // from the command up, so filled from the end
+    {
+        int length = 0;
+
+        while(step->command->options != NULL && step->command->options[length].long_name != NULL)
+            length++;
+
+        end -= length;
+
+        if(length > 0)
+            memcpy(options + end, step->command->options, sizeof(*options) * length);
+    }
+
+    parser = cmdf_parser_create(options, tree->flags); // the options are copied by the parser
+    allocator_free(&default_allocator, options);
+
+    if(parser == NULL)
+        return NULL;
+
+    parser->command = path->command;
+
+    for(step = path; step != NULL; step = step->parent)
+    {
+        if(step->command->usage != NULL)
+        {
+            parser->info_usage = step->command->usage;
+            break;
+        }
+    }
+
+    return parser;
+}
+
+
+
+/**
+ * @brief Gets the parser of a command, compiling it on the first call.
+ * @param tree: Tree of the command.
+ * @param parent: Parser of the command above, NULL for the root.
+ * @param path: The command and the commands above.
+ * @return Returns the parser, NULL if there is no memory.
+ */
+const cmdf_parser *command_tree_parser_get(const cmdf_command_tree *tree, const cmdf_parser *parent, const cmdf_command_path *path)
+{
+    cmdf_command_tree *cache_owner = (cmdf_command_tree*)tree;
+    const cmdf_parser *parser = NULL;
+    unsigned int slot;
+
+    pthread_mutex_lock(&(cache_owner->lock));
+
+    if((cache_owner->entries_len + 1) * 2 > cache_owner->mask + 1) // keep the load factor at most 0.5, moving the parsers to a table twice as big
+    {
+        unsigned int mask = cache_owner->mask * 2 + 1;
+        cmdf_command_entry *entries = allocator_calloc(&default_allocator, (size_t)mask + 1, sizeof(*entries));
+
+        if(entries == NULL)
+        {
+            pthread_mutex_unlock(&(cache_owner->lock));
+            return NULL;
+        }
+
+        for(unsigned int old = 0; old <= cache_owner->mask; old++)
+        {
+            if(cache_owner->entries[old].command == NULL)
+                continue;
+
+            slot = command_tree_slot(cache_owner->entries[old].parent, cache_owner->entries[old].command, mask);
+
+            while(entries[slot].command != NULL)
+                slot = (slot + 1) & mask;
+
+            entries[slot] = cache_owner->entries[old];
+        }
+
+        allocator_free(&default_allocator, cache_owner->entries);
+        cache_owner->entries = entries;
+        cache_owner->mask = mask;
+    }
+
+    slot = command_tree_slot(parent, path->command, cache_owner->mask);
+
+    while(cache_owner->entries[slot].command != NULL)
+    {
+        if(cache_owner->entries[slot].command == path->command && cache_owner->entries[slot].parent == parent)
+        {
+            parser = cache_owner->entries[slot].parser;
+            break;
+        }
+
+        slot = (slot + 1) & cache_owner->mask;
+    }
+
+    if(parser == NULL)
+    {
+        cmdf_parser *created = command_parser_create(tree, path);
+
+        if(created != NULL)
+        {
+            cache_owner->entries[slot] = (cmdf_command_entry){parent, path->command, created};
+            cache_owner->entries_len++;
+        }
+
+        parser = created;
+    }
+
+    pthread_mutex_unlock(&(cache_owner->lock));
+
+    return parser;
+}
+
+
+
+/**
+ * @brief Parses the arguments of a command up to the name of one of its subcommands, which then parses the rest.
+ * @param tree: Tree of the command.
+ * @param state: Parse in progress, with the parser of the command.
+ * @param path: The command and the commands above.
+ * @param argc: Number of arguments in argv.
+ * @param argv: Array of strings containing the arguments.
+ * @param command: Receives the last command selected.
+ * @return Returns the code of the first error found, 0 if none.
+ */
+int command_parse(const cmdf_command_tree *tree, cmdf_parse_state *state, const cmdf_command_path *path, int argc, char **argv, const cmdf_command **command)
+{
+    *command = path->command;
+
+    while(state->argument_index < argc)
+    {
+        char *argument = argv[state->argument_index];
+        const cmdf_option *pending = state->pending_option;
+
+        // a subcommand name goes where a floating argument would
+        if(argument[0] != '-' && path->command->commands != NULL && (pending == NULL || (pending->argq > 0 && state->pending_count >= pending->argq)))
+        {
+            const cmdf_command *subcommand = command_find(path->command, argument);
+
+            if(subcommand != NULL)
+            {
+                cmdf_command_path subpath = {subcommand, path, (subcommand->parse_function != NULL) ? subcommand->parse_function : path->parse_function};
+                const cmdf_parser *parser;
+
+#if defined(CMDF_ENABLE_STATS)
+                cmdf_stats stats = stats_current; // a parser compiled now restarts the statistics
+#endif
+
+                parser = command_tree_parser_get(tree, state->parser, &subpath);
+
+#if defined(CMDF_ENABLE_STATS)
+                stats_current = stats;
+#endif
+
+                *command = subcommand;
+
+                if(parser == NULL)
+                {
+                    error_handler_parse_options_internal(state->result, tree->flags, PARSER_ERROR_OUT_OF_MEMORY, state->argument_index, NULL, "No memory for the options of the command %s.\n", subcommand->name);
+                    return state->result->errors[0].code;
+                }
+
+                for(int e = 0; e < parser->registration_result.error_count; e++) // already printed when the parser was compiled
+                {
+                    if(state->result->error_count < CMDF_MAX_ERRORS)
+                        state->result->errors[state->result->error_count] = parser->registration_result.errors[e];
+
+                    state->result->error_count++;
+                }
+
+                if(parser->registration_result.error_count > 0 || parse_wide_keys_check(parser, subpath.parse_function != NULL, state->result) != 0)
+                    return state->result->errors[0].code;
+
+                unsigned long options_passed_bitset[parser->bitset_words];
+
+                // the options of the command above have the same index here, and the ones already passed stay passed
+                option_parser_end(state);
+                memset(options_passed_bitset, 0, sizeof(options_passed_bitset));
+                memcpy(options_passed_bitset, state->options_passed_bitset, sizeof(*options_passed_bitset) * state->parser->bitset_words);
+
+                state->parser = parser;
+                state->parse_function = subpath.parse_function;
+                state->options_passed_bitset = options_passed_bitset;
+                state->argument_index++;
+
+                return command_parse(tree, state, &subpath, argc, argv, command);
+            }
+        }
+
+        parse_state_push(state, argument);
+    }
+
+    return parse_state_end(state);
+}
+
+
+
+/**
+ * @brief Checks if an option is offered by the completion, and records it as offered.
+ * Options already given are left out, but for counters and lists, and an option and its aliases are offered once, by the
+ * option itself when its name has the prefix too.
+ * @param parser: Parser with the options array.
+ * @param option: Index of the option, its long name starts with the prefix.
+ * @param prefix: Start of the word being completed, without the dashes.
+ * @param prefix_length: Length of the prefix.
+ * @param passed: Options given before the cursor, by the index of the option an alias stands for.
+ * @param offered: Options already offered, by the same index.
+ * @return Returns 1 if the option is to be written.
+ */
+int complete_option_offered(const cmdf_parser *parser, int option, const char *prefix, size_t prefix_length, const unsigned long *passed, unsigned long *offered)
+{
+    const cmdf_option *current = &(parser->options[option]);
+    int head = option_alias_head(parser->options, option);
+
+    if(current->parameters & (OPTION_HIDDEN | OPTION_NO_LONG_KEY))
+        return 0;
+
+    if(option < DEFAULT_OPTIONS_LENGTH && !(parser->flags & PARSER_FLAG_USE_PREDEFINED_OPTIONS))
+        return 0;
+
+    if(BITSET_TEST(passed, head) && current->binding.action != BINDING_COUNT && current->binding.action != BINDING_APPEND)
+        return 0;
+
+    if(option != head && !strncmp(parser->options[head].long_name, prefix, prefix_length)) // the option comes by its own name
+        return 0;
+
+    if(BITSET_TEST(offered, head))
+        return 0;
+
+    BITSET_SET(offered, head);
+    return 1;
+}
+
+
+
+/**
+ * @brief Writes the long names of a subtree of the trie, in alphabetical order.
+ * @param parser: Parser with the options array.
+ * @param trie: Long name trie of the parser.
+ * @param node: Root of the subtree, where the prefix ends.
+ * @param prefix: Start of the word being completed, without the dashes.
+ * @param prefix_length: Length of the prefix.
+ * @param passed: Options given before the cursor.
+ * @param offered: Options already offered.
+ * @param out: Stream to write to.
+ * @return Returns the number of names written.
+ */
+int complete_options_write(const cmdf_parser *parser, const cmdf_name_trie *trie, unsigned int node, const char *prefix, size_t prefix_length, const unsigned long *passed, unsigned long *offered, FILE *out)
+{
+    const cmdf_name_trie_node *current = &(trie->nodes[node]);
+    int count = 0;
+
+    if(current->exact != NAME_TRIE_NO_OPTION && complete_option_offered(parser, current->exact, prefix, prefix_length, passed, offered))
+    {
+        fprintf(out, "--%s\n", parser->options[current->exact].long_name);
+        count++;
+    }
+
+    for(unsigned int child = 0; child < current->children_len; child++)
+        count += complete_options_write(parser, trie, current->children + child, prefix, prefix_length, passed, offered, out);
+
+    return count;
+}
+
+
+
+/**
+ * @brief Writes the long names that start with a prefix comparing every name, in the order of the options.
+ * Used when the parser has no trie yet: a completion from the shell runs a new process on every TAB, and scanning
+ * the names once costs much less than building the trie for a single query.
+ * @param parser: Parser with the options array.
+ * @param prefix: Start of the word being completed, without the dashes.
+ * @param prefix_length: Length of the prefix.
+ * @param passed: Options given before the cursor.
+ * @param offered: Options already offered.
+ * @param out: Stream to write to.
+ * @return Returns the number of names written.
+ */
+int complete_options_scan(const cmdf_parser *parser, const char *prefix, size_t prefix_length, const unsigned long *passed, unsigned long *offered, FILE *out)
+{
+    int count = 0;
+
+    for(int i = 0; i < parser->options_len; i++)
+    {
+        const char *name = parser->options[i].long_name;
+
+        if(name != NULL && !strncmp(name, prefix, prefix_length) && complete_option_offered(parser, i, prefix, prefix_length, passed, offered))
+        {
+            fprintf(out, "--%s\n", name);
+            count++;
+        }
+    }
+
+    return count;
+}
+
+
+
+/**
+ * @brief Writes the completions of the word at the cursor, once the words before it were followed.
+ * @param path: Command being parsed, NULL without a command tree.
+ * @param parser: Parser of the command.
+ * @param passed: Options given before the cursor.
+ * @param pending: Option waiting for arguments, NULL if none.
+ * @param pending_count: Arguments it already took.
+ * @param word: Word being completed.
+ * @param build_trie: Set to build the trie of the long names when the parser has none yet, else the names are scanned.
+ * @param out: Stream to write to.
+ * @return Returns the number of completions written.
+ */
+int complete_word(const cmdf_command_path *path, const cmdf_parser *parser, const unsigned long *passed, const cmdf_option *pending, int pending_count, const char *word, int build_trie, FILE *out)
+{
+    size_t word_length = strlen(word);
+    int count = 0;
+
+    if(word[0] == '-') // long names, also for a single '-'
+    {
+        // abbreviations and generated parsers have the trie already
+        int built = (__atomic_load_n(&(parser->name_trie.nodes), __ATOMIC_ACQUIRE) != NULL);
+        const cmdf_name_trie *trie = (built || build_trie) ? name_trie_get(parser) : NULL;
+        const char *prefix = word + ((word[1] == '-') ? 2 : 1);
+        int inside;
+        int node;
+        unsigned long offered[parser->bitset_words];
+
+        memset(offered, 0, sizeof(offered));
+
+        if(trie == NULL)
+            return complete_options_scan(parser, prefix, strlen(prefix), passed, offered, out);
+
+        node = name_trie_find(trie, prefix, '\0', &inside);
+
+        if(node < 0)
+            return 0;
+
+        return complete_options_write(parser, trie, (unsigned int)node, prefix, strlen(prefix), passed, offered, out);
+    }
+
+    if(pending != NULL && (pending->argq == -1 || pending_count < pending->argq)) // an argument of the option
+    {
+        if(pending->binding.action != BINDING_ENUM || pending->binding.names == NULL)
+            return 0;
+
+        for(int i = 0; pending->binding.names[i] != NULL; i++)
+        {
+            if(!strncmp(pending->binding.names[i], word, word_length))
+            {
+                fprintf(out, "%s\n", pending->binding.names[i]);
+                count++;
+            }
+        }
+
+        return count;
+    }
+
+    if(path != NULL && path->command->commands != NULL) // where a subcommand can go
+    {
+        for(const cmdf_command *command = path->command->commands; command->name != NULL; command++)
+        {
+            if(!strncmp(command->name, word, word_length))
+            {
+                fprintf(out, "%s\n", command->name);
+                count++;
+            }
+        }
+    }
+
+    return count;
+}
+
+
+
+/**
+ * @brief Follows the words before the cursor as a parse would, without calling anything, then completes the word at the cursor.
+ * Subcommands switch to their parser as in "command_parse".
+ * @param tree: Tree of the command, NULL without a command tree.
+ * @param path: Command being parsed, NULL without a command tree.
+ * @param parser: Parser of the command.
+ * @param passed: Options already given, by the index of the option an alias stands for.
+ * @param words: The command line.
+ * @param index: First word to follow.
+ * @param cursor: Index of the word being completed, every word before it is followed.
+ * @param word: Word being completed.
+ * @param build_trie: Set to build the trie of the long names when the parser has none yet, see "complete_word".
+ * @param out: Stream to write to.
+ * @return Returns the number of completions written.
+ */
+int complete_walk(const cmdf_command_tree *tree, const cmdf_command_path *path, const cmdf_parser *parser, unsigned long *passed, char **words, int index, int cursor, const char *word, int build_trie, FILE *out)
+{
+    const cmdf_option *pending = NULL;
+    int pending_count = 0;
+
+    for(; index < cursor; index++)
+    {
+        char *current = words[index];
+        const cmdf_option *option;
+
+        if(current[0] != '-')
+        {
+            const cmdf_command *subcommand = NULL;
+
+            if(path != NULL && path->command->commands != NULL && (pending == NULL || (pending->argq > 0 && pending_count >= pending->argq)))
+                subcommand = command_find(path->command, current);
+
+            if(subcommand != NULL)
+            {
+                cmdf_command_path subpath = {subcommand, path, NULL};
+                const cmdf_parser *subparser = command_tree_parser_get(tree, parser, &subpath);
+
+                if(subparser == NULL || subparser->registration_result.error_count > 0)
+                    return 0;
+
+                unsigned long subpassed[subparser->bitset_words];
+
+                memset(subpassed, 0, sizeof(subpassed));
+                memcpy(subpassed, passed, sizeof(*passed) * parser->bitset_words);
+
+                return complete_walk(tree, &subpath, subparser, subpassed, words, index + 1, cursor, word, build_trie, out);
+            }
+
+            pending_count += (pending != NULL);
+            continue;
+        }
+
+        pending = NULL; // another option ends the pending one
+        pending_count = 0;
+
+        if(current[1] == '-')
+        {
+            size_t name_length;
+
+            option = get_option_by_long_name_until(current + 2, '=', &name_length, &(parser->long_name_index));
+
+            if(option == NULL && (parser->flags & PARSER_FLAG_ALLOW_ABBREVIATIONS))
+            {
+                unsigned int node;
+                int found = name_trie_lookup(&(parser->name_trie), current + 2, '=', &node);
+
+                option = (found >= 0) ? &(parser->options[found]) : NULL;
+            }
+
+            if(option != NULL)
+            {
+                BITSET_SET(passed, option_alias_head(parser->options, (int)(option - parser->options)));
+                pending = (option->argq != 0) ? option : NULL;
+                pending_count = (current[2 + name_length] == '='); // "--name=value" took its first argument
+            }
+        }
+        else
+        {
+            for(int j = 1; current[j] != '\0'; j++)
+            {
+                option = get_option_by_key(current[j], parser->key_map);
+
+                if(option == NULL)
+                    continue;
+
+                BITSET_SET(passed, option_alias_head(parser->options, (int)(option - parser->options)));
+                pending = (option->argq != 0) ? option : NULL;
+
+                if(j == 1 && pending != NULL && current[2] != '\0') // "-ovalue", the rest of the word is its first argument
+                {
+                    pending_count = 1;
+                    break;
                 }
             }
+        }
+    }
+
+    return complete_word(path, parser, passed, pending, pending_count, word, build_trie, out);
+}
+
+
+
+/**
+ * @brief Writes the completion script of a shell, with the program name put in.
+ * @param out: Stream to write to.
+ * @param script: Script with "@PROGRAM@" and "@FUNCTION@" in it.
+ * @param program: Path of the program, its last part is the name.
+ */
+void complete_script_write(FILE *out, const char *script, const char *program)
+{
+    const char *name = strrchr(program, '/');
+
+    name = (name != NULL) ? name + 1 : program;
+
+    while(*script != '\0')
+    {
+        if(!strncmp(script, "@PROGRAM@", 9))
+        {
+            fputs(name, out);
+            script += 9;
+        }
+        else if(!strncmp(script, "@FUNCTION@", 10))
+        {
+            for(const char *c = name; *c != '\0'; c++)
+                fputc((is_letter(*c) || (*c >= '0' && *c <= '9')) ? *c : '_', out);
+
+            script += 10;
+        }
+        else
+            fputc(*script++, out);
+    }
+}
+
+
+
+/**
+ * @brief Answers a completion query or writes a completion script, when the command line is one and the flag
+ * PARSER_FLAG_ENABLE_COMPLETION is set. The program exits after answering.
+ * @param tree: Tree of the command, NULL without a command tree.
+ * @param path: The root command, NULL without a command tree.
+ * @param parser: Parser of the program.
+ * @param argc: Number of arguments in argv.
+ * @param argv: The command line.
+ */
+void complete_main(const cmdf_command_tree *tree, const cmdf_command_path *path, const cmdf_parser *parser, int argc, char **argv)
+{
+    FILE *out = (parser->output != NULL) ? parser->output : stdout;
+
+    if(!(parser->flags & PARSER_FLAG_ENABLE_COMPLETION) || argc < 3)
+        return;
+
+    if(!strcmp(argv[1], CMDF_COMPLETE_SCRIPT_OPTION))
+    {
+        if(!strcmp(argv[2], "bash"))
+            complete_script_write(out, COMPLETE_SCRIPT_BASH, argv[0]);
+        else if(!strcmp(argv[2], "zsh"))
+            complete_script_write(out, COMPLETE_SCRIPT_ZSH, argv[0]);
+        else if(!strcmp(argv[2], "fish"))
+            complete_script_write(out, COMPLETE_SCRIPT_FISH, argv[0]);
+    }
+    else if(!strcmp(argv[1], CMDF_COMPLETE_OPTION))
+    {
+        int cursor = atoi(argv[2]);
+        int words_len = argc - 3;
+        char **words = argv + 3;
+        unsigned long passed[parser->bitset_words];
+
+        memset(passed, 0, sizeof(passed));
+
+        if(cursor < 1 || cursor > words_len)
+            cursor = words_len;
+
+        if(words_len > 0)
+            complete_walk(tree, path, parser, passed, words, 1, cursor, (cursor < words_len) ? words[cursor] : "", 0, out); // a process per TAB, no trie is built
+    }
+    else
+        return;
+
+    fflush(out);
+    exit(0);
+}
+
+
+
+/**
+ * @brief Parses a command line with a compiled parser, giving the arguments to a parse function, a view function or a wide parse function.
+ * @param parser: Parser made by "cmdf_parser_create".
+ * @param parse_function: User defined parse function, may be NULL.
+ * @param view_function: User defined view function, called instead of the parse function when not NULL.
+ * @param wide_function: User defined wide parse function, called instead of the parse function when not NULL.
+ * @param argc: Number of arguments in argv.
+ * @param argv: Array of strings containing the arguments, the first one is the program name.
+ * @param extern_user_variables_struct: Pointer to user defined struct.
+ * @param result: Result to receive the errors.
+ * @return Returns the code of the first error found, 0 if none.
+ */
+int parser_parse_argv(const cmdf_parser *parser, option_parse_function parse_function, option_view_function view_function, option_wide_function wide_function, int argc, char **argv, void *extern_user_variables_struct, cmdf_result *result)
+{
+    cmdf_parse_state state;
+    int i;
+
+    // options with registration errors are not parsed, the errors are reported again instead
+    *result = parser->registration_result;
+
+    if(result->error_count > 0 || parse_wide_keys_check(parser, parse_function != NULL || view_function != NULL, result) != 0)
+        return result->errors[0].code;
+
+    complete_main(NULL, NULL, parser, argc, argv); // a completion query from the shell never returns
+
+    unsigned long options_passed_bitset[parser->bitset_words];    // the options given on the cmd, one bit per option index
+
+    parse_state_begin(&state, parser, parse_function, extern_user_variables_struct, result, options_passed_bitset, 1);
+    state.view_function = view_function;
+    state.wide_function = wide_function;
+    state.argv = argv; // the arguments of an option can be given as a part of argv
+
+    // run for every argument passed on cmd, after the programs name
+    for(i = 1; i < argc; i++)
+    {
+        parse_state_push(&state, argv[i]);
+        i += parse_state_take_run(&state, argc); // the arguments of an option going to the span function, in one go
+    }
+
+    return parse_state_end(&state);
+}
+
+
+
+/* -------------------------------------------- Functions Implementations ---------------------------------------------- */
+
+
+/**
+ * @brief Set default value of cmdf_default_info_usage
+ */
+void set_cmdf_default_info_usage(const char *info_string)
+{
+    cmdf_default_info_usage = info_string;
+}
+
+
+
+/**
+ * @brief Set default value of cmdf_default_info_version
+ */
+void set_cmdf_default_info_version(const char *info_string)
+{
+    cmdf_default_info_version = info_string;
+}
+
+
+
+/**
+ * @brief Set default value of cmdf_default_info_contact
+ */
+void set_cmdf_default_info_contact_info(const char *info_string)
+{
+    cmdf_default_info_contact_info = info_string;
+}
+
+
+
+/**
+ * @brief Makes an arena over a user buffer.
+ */
+void cmdf_arena_init(cmdf_arena *arena, void *buffer, size_t size)
+{
+    arena->buffer = (unsigned char*)buffer;
+    arena->size = size;
+    arena->used = 0;
+    arena->last = 0;
+}
+
+
+
+/**
+ * @brief Releases every block taken from an arena at once.
+ */
+void cmdf_arena_reset(cmdf_arena *arena)
+{
+    arena->used = 0;
+    arena->last = 0;
+}
+
+
+
+/**
+ * @brief Makes an allocator that takes its blocks from an arena.
+ */
+cmdf_allocator cmdf_arena_allocator(cmdf_arena *arena)
+{
+    cmdf_allocator allocator = {arena_allocator_alloc, arena_allocator_realloc, arena_allocator_free, arena};
+
+    return allocator;
+}
+
+
+
+/**
+ * @brief Compiles a parser for an options array.
+ */
+cmdf_parser *cmdf_parser_create(cmdf_option *registered_options, PARSER_FLAGS_Typedef flags)
+{
+    return cmdf_parser_create_with_allocator(registered_options, flags, NULL);
+}
+
+
+
+/**
+ * @brief Compiles a parser for an options array, taking all its memory from an allocator.
+ */
+cmdf_parser *cmdf_parser_create_with_allocator(cmdf_option *registered_options, PARSER_FLAGS_Typedef flags, const cmdf_allocator *allocator)
+{
+    if(allocator == NULL)
+        allocator = &default_allocator;
+
+#if defined(CMDF_ENABLE_STATS)
+    memset(&stats_current, 0, sizeof(stats_current));
+#endif
+
+    STATS_TIME_BEGIN(start);
+
+    cmdf_parser *parser = allocator_calloc(allocator, 1, sizeof(*parser));
+
+    if(parser == NULL)
+        return NULL;
+
+    parser->allocator = *allocator;
+
+    if(parse_registered_options(registered_options, flags, parser) != 0)
+    {
+        cmdf_parser_free(parser);
+        return NULL;
+    }
+
+    STATS_TIME_END(prepare_ns, start);
+
+#if defined(CMDF_ENABLE_STATS)
+    parser->prepare_stats = stats_current;
+#endif
+
+    return parser;
+}
+
+
+
+/**
+ * @brief Parses a command line with a compiled parser.
+ */
+int cmdf_parser_parse(const cmdf_parser *parser, option_parse_function parse_function, int argc, char **argv, void *extern_user_variables_struct)
+{
+    cmdf_result result;
+
+    return cmdf_parser_parse_result(parser, parse_function, argc, argv, extern_user_variables_struct, &result);
+}
+
+
+
+/**
+ * @brief Parses a command line with a compiled parser, reporting the errors on a result.
+ */
+int cmdf_parser_parse_result(const cmdf_parser *parser, option_parse_function parse_function, int argc, char **argv, void *extern_user_variables_struct, cmdf_result *result)
+{
+    return parser_parse_argv(parser, parse_function, NULL, NULL, argc, argv, extern_user_variables_struct, result);
+}
+
+
+
+/**
+ * @brief Parses a command line with a compiled parser, giving the arguments as views.
+ */
+int cmdf_parser_parse_views(const cmdf_parser *parser, option_view_function view_function, int argc, char **argv, void *extern_user_variables_struct, cmdf_result *result)
+{
+    return parser_parse_argv(parser, NULL, view_function, NULL, argc, argv, extern_user_variables_struct, result);
+}
+
+
+
+/**
+ * @brief Parses a command line with a compiled parser, giving the options by their ids.
+ */
+int cmdf_parser_parse_wide(const cmdf_parser *parser, option_wide_function wide_function, int argc, char **argv, void *extern_user_variables_struct, cmdf_result *result)
+{
+    return parser_parse_argv(parser, NULL, NULL, wide_function, argc, argv, extern_user_variables_struct, result);
+}
+
+
+
+/**
+ * @brief Parses the arguments read from a file descriptor, as they arrive, in a small buffer on the stack.
+ */
+int cmdf_parser_parse_fd(const cmdf_parser *parser, option_parse_function parse_function, int file_descriptor, char delimiter, void *extern_user_variables_struct, cmdf_result *result)
+{
+    char buffer[CMDF_STREAM_BUFFER_LENGTH]; // a parse never takes memory from the parser allocator, larger buffers are given by the caller
+
+    return cmdf_parser_parse_fd_buffer(parser, parse_function, file_descriptor, delimiter, buffer, sizeof(buffer), extern_user_variables_struct, result);
+}
+
+
+
+/**
+ * @brief Parses the arguments read from a file descriptor, as they arrive, in the buffer of the caller.
+ */
+int cmdf_parser_parse_fd_buffer(const cmdf_parser *parser, option_parse_function parse_function, int file_descriptor, char delimiter, char *buffer, size_t buffer_size, void *extern_user_variables_struct, cmdf_result *result)
+{
+    cmdf_parse_state state;
+    cmdf_result local_result;
+
+    if(result == NULL)
+        result = &local_result;
+
+    // options with registration errors are not parsed, the errors are reported again instead
+    *result = parser->registration_result;
+
+    if(result->error_count > 0 || parse_wide_keys_check(parser, parse_function != NULL, result) != 0)
+        return result->errors[0].code;
+
+    if(buffer == NULL || buffer_size < 2) // an argument and its '\0'
+    {
+        error_handler_parse_options_internal(result, parser->flags, PARSER_ERROR_ARGUMENT_TOO_LONG, -1, NULL, "The buffer of the arguments stream has %zu bytes, it needs at least 2.\n", (buffer != NULL) ? buffer_size : 0);
+        return result->errors[0].code;
+    }
+
+    unsigned long options_passed_bitset[parser->bitset_words];    // the options given on the stream, one bit per option index
+
+    parse_state_begin(&state, parser, parse_function, extern_user_variables_struct, result, options_passed_bitset, 0);
+
+    stream_parse(&state, file_descriptor, delimiter, buffer, buffer_size);
+
+    return parse_state_end(&state);
+}
+
+
+
+/**
+ * @brief Parses the arguments of a command string, splitting it in place.
+ */
+int cmdf_parser_parse_string(const cmdf_parser *parser, option_parse_function parse_function, char *command, void *extern_user_variables_struct, cmdf_result *result)
+{
+    cmdf_parse_state state;
+    cmdf_result local_result;
+    char *cursor = command;
+    char *end = command + strlen(command);
+    char *token;
+    int literal;
+
+    if(result == NULL)
+        result = &local_result;
+
+    // options with registration errors are not parsed, the errors are reported again instead
+    *result = parser->registration_result;
+
+    if(result->error_count > 0 || parse_wide_keys_check(parser, parse_function != NULL, result) != 0)
+        return result->errors[0].code;
+
+    unsigned long options_passed_bitset[parser->bitset_words];    // the options given on the string, one bit per option index
+
+    parse_state_begin(&state, parser, parse_function, extern_user_variables_struct, result, options_passed_bitset, 0);
+
+    // every argument goes to the parse as soon as it is split
+    while((token = command_token_next(&cursor, end, &literal, 1)) != NULL)
+        parse_state_push(&state, token);
+
+    return parse_state_end(&state);
+}
+
+
+
+/**
+ * @brief Batch worker thread, takes chunks of command lines from the queue until it is empty.
+ * @param queue_ptr: Pointer to the shared "cmdf_batch_queue".
+ */
+void *batch_parse_worker(void *queue_ptr)
+{
+    cmdf_batch_queue *queue = (cmdf_batch_queue*)queue_ptr;
+    int first, last, i;
+
+    while(1)
+    {
+        pthread_mutex_lock(&(queue->lock));
+        first = queue->next_item;
+        queue->next_item = (first + BATCH_CHUNK_LENGTH < queue->items_len) ? (first + BATCH_CHUNK_LENGTH) : queue->items_len;
+        last = queue->next_item;
+        pthread_mutex_unlock(&(queue->lock));
+
+        if(first >= last)
+            break;
+
+        for(i = first; i < last; i++)
+        {
+            cmdf_batch_item *item = &(queue->items[i]);
+            item->error = cmdf_parser_parse_result(queue->parser, queue->parse_function, item->argc, item->argv, item->extern_user_variables_struct, &(item->result));
+        }
+    }
+
+    return NULL;
+}
+
+
+
+/**
+ * @brief Parses many command lines with the same parser, spread over a pool of threads.
+ */
+int cmdf_parser_parse_batch(const cmdf_parser *parser, option_parse_function parse_function, cmdf_batch_item *items, int items_len, int threads)
+{
+    cmdf_batch_queue queue;
+    int failed = 0;
+    int i;
+
+    if(threads <= 0)
+    {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (cores > 0) ? (int)cores : 1;
+    }
+
+    if(threads > BATCH_MAX_THREADS)
+        threads = BATCH_MAX_THREADS;
+
+    if(threads > (items_len + BATCH_CHUNK_LENGTH - 1) / BATCH_CHUNK_LENGTH) // no use for threads without a chunk to take
+        threads = (items_len + BATCH_CHUNK_LENGTH - 1) / BATCH_CHUNK_LENGTH;
+
+    queue.parser = parser;
+    queue.parse_function = parse_function;
+    queue.items = items;
+    queue.items_len = items_len;
+    queue.next_item = 0;
+    pthread_mutex_init(&(queue.lock), NULL);
+
+    if(threads <= 1)
+    {
+        batch_parse_worker(&queue);
+    }
+    else
+    {
+        pthread_t workers[BATCH_MAX_THREADS - 1]; // on the stack, generated parsers have no allocator and arenas never give memory back
+        int started = 0;
 
+        for(i = 0; i < threads - 1; i++) // the calling thread is the last one
+        {
+            if(pthread_create(&(workers[started]), NULL, batch_parse_worker, &queue) == 0)
+                started++;
+        }
 
+        batch_parse_worker(&queue); // the calling thread works too, and finishes the queue alone if no thread could start
 
-            break;
+        for(i = 0; i < started; i++)
+            pthread_join(workers[i], NULL);
+    }
 
-        case __VERSION_KEY:  // --version
-            if(cmdf_default_info_version!=NULL)
-                printf("%s\n",cmdf_default_info_version);
-            break;
+    pthread_mutex_destroy(&(queue.lock));
 
-        case __INFO_KEY:     // --info
-            if(cmdf_default_info_contact_info!=NULL)
-                printf("%s\n",cmdf_default_info_contact_info);
-            break;
+    for(i = 0; i < items_len; i++)
+    {
+        if(items[i].error != PARSER_ERROR_NONE)
+            failed++;
     }
 
-    return;
+    return failed;
 }
 
 
 
 /**
- * @brief Check if key is registered.
- * @param key: Char key to be verified.
- * @param options_array: Options array to check against.
+ * @brief Set the usage info printed by --help for a single parser.
  */
-int is_option_registered(char key, char *options_registered_array)
-{    
-    if(strchr(options_registered_array, key)!=NULL)
-        return 1;
-    else
-        return 0; // no key found return 0
+void cmdf_parser_set_info_usage(cmdf_parser *parser, const char *info_string)
+{
+    parser->info_usage = info_string;
 }
 
 
 
 /**
- * @brief Runs trought an array of options looking for the correponding option for a given long name.
- * @param long_name: The full name of the options.
- * @param options_array: Options array to check against.
- * @return Returns a pointer to the option struct.
+ * @brief Set the version info printed by --version for a single parser.
  */
-cmdf_option *get_option_by_long_name(char *long_name, cmdf_option *options_array)
+void cmdf_parser_set_info_version(cmdf_parser *parser, const char *info_string)
 {
-    int i = 0;
-
-    while(options_array[i].long_name != NULL)
-    {
-        if(!strcmp(long_name, options_array[i].long_name))
-            return &(options_array[i]);
-
-        i++;
-    }
-
-    return NULL;
+    parser->info_version = info_string;
 }
 
 
 
 /**
- * @brief Runs trought an array of options looking for the correponding option for a given char key.
- * @param key: The char key of the option.
- * @param options_array: Options array to check against.
- * @return Returns a pointer to the option struct.
+ * @brief Set the contact info printed by --info for a single parser.
  */
-cmdf_option *get_option_by_key(char key, cmdf_option *options_array)
+void cmdf_parser_set_info_contact_info(cmdf_parser *parser, const char *info_string)
 {
-    int i = 0;
+    parser->info_contact_info = info_string;
+}
 
-    while(options_array[i].long_name != NULL)
-    {
-        if(options_array[i].key == key)
-            return &(options_array[i]);
 
-        i++;
-    }
 
-    return NULL;
+/**
+ * @brief Set the stream where the default options of a parser write to.
+ */
+void cmdf_parser_set_output(cmdf_parser *parser, FILE *output)
+{
+    parser->output = output;
 }
 
 
 
 /**
- * @brief Tweak options array, substituting aliases and duplicates, etc.
- * @param options_array: Options array to check against.
- * @param flags: Parser flags to be used in error handling inside function.
- * @param options_required_ptr: Pointer to array of strings, to be allocated and receive program required options to work correctly and its aliases.
- * @param options_registered_ptr: Pointer to string, to be allocated and receive all the registered options.
- * @param options_default_ptr: Pointer to string, to be allocated and receive all the default options.
+ * @brief Loads a config file giving the options that are not on the command line.
  */
-void parse_registered_options(cmdf_option **options_array_ptr, PARSER_FLAGS_Typedef flags, char options_required_ptr[0xFF][0xFF], char options_registered_ptr[0xFF], char options_default_ptr[0xFF])
+int cmdf_parser_set_config_file(cmdf_parser *parser, const char *path)
 {
-    int i;
-    int j;
+    const cmdf_allocator *allocator = (parser->allocator.alloc != NULL) ? &(parser->allocator) : &default_allocator; // generated parsers keep it in the heap
+    cmdf_result result;
+    cmdf_config *config;
+    int error;
 
-    // to check for not optional options    
-    int flag_option_was_non_alias_and_required = 0;
+    config_free(parser->config, allocator);
+    parser->config = NULL;
 
-    // to check for duplicate keys
-    char *all_keys = calloc(sizeof(*all_keys)*0xFF,1);
+    if(path == NULL)
+        return PARSER_ERROR_NONE;
 
-    // to check for aliases
-    cmdf_option last_option = {0};
+    memset(&result, 0, sizeof(result));
 
+    config = config_create(parser, allocator);
+    error = (config != NULL) ? config_load(config, parser, path, &result) : PARSER_ERROR_OUT_OF_MEMORY;
 
-    /* Create new array with default and user defined options to be parsed */
+    if(error != PARSER_ERROR_NONE)
+    {
+        config_free(config, allocator);
 
-    int options_len = 0;
+        if(error == PARSER_ERROR_CONFIG_FILE)
+            error_handler_parse_options_internal(NULL, parser->flags, PARSER_ERROR_CONFIG_FILE, -1, NULL, "The config file %s can't be read.\n", path);
+        else
+            error_handler_parse_options_internal(NULL, parser->flags, PARSER_ERROR_OUT_OF_MEMORY, -1, NULL, "Not enough memory to load the config file %s.\n", path);
 
-    while((*options_array_ptr)[options_len].long_name != NULL)
-        options_len++;
+        return error;
+    }
 
-    int total_options_length = options_len + DEFAULT_OPTIONS_LENGTH;
+    parser->config = config; // the lines with errors are left out
 
-    cmdf_option *options_array = calloc(sizeof(cmdf_option)*(total_options_length+1),1); // new array
+    return (result.error_count > 0) ? result.errors[0].code : PARSER_ERROR_NONE;
+}
 
-    memcpy(options_array, default_options, sizeof(cmdf_option)*DEFAULT_OPTIONS_LENGTH); // copy default options
-    memcpy((options_array + DEFAULT_OPTIONS_LENGTH), (*options_array_ptr), sizeof(cmdf_option)*options_len); // copy user options
 
-    options_array[total_options_length].long_name = NULL; // last element shall be empty
 
-    *options_array_ptr = options_array;   // make the passed pointer point to new array
+/**
+ * @brief Set the constraints between the options of a parser.
+ */
+int cmdf_parser_set_constraints(cmdf_parser *parser, const cmdf_constraint *constraints)
+{
+    const cmdf_allocator *allocator = (parser->allocator.alloc != NULL) ? &(parser->allocator) : &default_allocator; // generated parsers keep them in the heap
+    cmdf_result result;
 
-    // there's no need to free the original pointer to user defined options struct, because it is stack allocated.
+    constraints_free(parser);
 
+    if(constraints == NULL)
+        return PARSER_ERROR_NONE;
 
+    memset(&result, 0, sizeof(result));
 
-    /* Run trought options, incrementing the size and substituting aliases, (OPTION_ALIAS). */
+    if(constraints_compile(parser, constraints, allocator, &result) != 0)
+    {
+        if(allocator == &(parser->allocator))
+            constraints_free(parser);
+        else
+            parser->constraints_len = 0; // generated parsers don't release, the tables are unused without constraints
 
-    options_len = 0;
-    i = -1;
-    j = 0;
+        error_handler_parse_options_internal(NULL, parser->flags, PARSER_ERROR_OUT_OF_MEMORY, -1, NULL, "Not enough memory to compile the constraints.\n");
+        return PARSER_ERROR_OUT_OF_MEMORY;
+    }
 
-    while(options_array[options_len].long_name != NULL)
-    {
-        // Duplicates
-        if(strchr(all_keys, options_array[options_len].key) == NULL) // if the key is not a DUPLICATE
-            strcat_char(all_keys, options_array[options_len].key); // cat key
-        else{
-            if(options_array[options_len].parameters & OPTION_NO_CHAR_KEY)
-                error_handler_parse_options_internal(flags, "The option --%s 'key' is already registered by another option.\n", options_array[options_len].long_name);
-            else
-                error_handler_parse_options_internal(flags, "The key -%c from option --%s is already registered by another option.\n", options_array[options_len].key, options_array[options_len].long_name);
-        }
+    return (result.error_count > 0) ? result.errors[0].code : PARSER_ERROR_NONE;
+}
 
 
 
-        // Key ascii check
-        if(options_array[options_len].key == 0){
-            if(options_array[options_len].parameters & OPTION_NO_CHAR_KEY)
-                error_handler_parse_options_internal(flags,"The option --%s have the char key set to 0, the 0 key is reserved, please change to another int or char.\n",options_array[options_len].key,options_array[options_len].long_name);
-            else
-                error_handler_parse_options_internal(flags,"The option -%c / --%s have the char key set to 0, the 0 key is reserved, please change to another int or char.\n",options_array[options_len].key,options_array[options_len].long_name);
-        }
+/**
+ * @brief Set a function that receives the arguments of the options in runs.
+ */
+void cmdf_parser_set_span_function(cmdf_parser *parser, option_span_function span_function)
+{
+    parser->span_function = span_function;
+}
 
-        if( (options_array[options_len].parameters & OPTION_NO_CHAR_KEY) && is_letter(options_array[options_len].key)) // if no char key, then it must check to see if the key is a non assci letter
-            error_handler_parse_options_internal(flags, "An option with (OPTION_NO_CHAR_KEY) specified must be a non ascii alphabetical character. Option: -%c / --%s.\n", options_array[options_len].key, options_array[options_len].long_name);
 
-        if( !(options_array[options_len].parameters & OPTION_NO_CHAR_KEY) && !is_letter(options_array[options_len].key)) // if char key, then it must check to see if the key is a asci letter
-            error_handler_parse_options_internal(flags, "An option with a specified char key must be a ascii alphabetical character. Option: --%s.\n", options_array[options_len].long_name);
 
-        
+/**
+ * @brief Finds the registered option whose long name is the closest to a misspelled one.
+ */
+const char *cmdf_parser_suggest(const cmdf_parser *parser, const char *name)
+{
+    const cmdf_option *option = suggest_option(parser, name, strlen(name));
 
-        // Check for 0 key, reserved by the program
-        if(options_array[options_len].key == 0)
-            error_handler_parse_options_internal(flags, "No defined option should use the '0' key, it is reserved. The option --%s has key '0'\n",options_array[options_len].long_name);
+    return (option != NULL) ? option->long_name : NULL;
+}
 
 
 
-        // Optional options
-        if(!(options_array[options_len].parameters & OPTION_OPTIONAL) && !(options_array[options_len].parameters & OPTION_ALIAS))    // if not optional and non alias, !(OPTION_OPTIONAL)
-        {
-            flag_option_was_non_alias_and_required = 1;
-            i++;
-            strcat_char(options_required_ptr[i], options_array[options_len].key);
-        }
-        else if((options_array[options_len].parameters & OPTION_ALIAS) && flag_option_was_non_alias_and_required == 1)   // if this is a alias and last option was non optional
-        {
-            strcat_char(options_required_ptr[i], options_array[options_len].key);
-        }
-        else // if a new optional option appears, then stop adding aliases
-        {
-            flag_option_was_non_alias_and_required = 0;
-        }
-        
+/**
+ * @brief Writes the completions of a word of a command line.
+ */
+int cmdf_parser_complete(const cmdf_parser *parser, int cursor, int words_len, char **words, FILE *out)
+{
+    unsigned long passed[parser->bitset_words];
 
+    if(out == NULL)
+        out = stdout;
 
-        // Aliases
-        if(options_array[options_len].parameters & OPTION_ALIAS) // check for aliases, (OPTION_ALIAS)
-        {
-            if(last_option.long_name == NULL) // if the first registered option is an alias, then its obvisually ilegal
-                error_handler_parse_options_internal(flags, "The first option must be a non alias option, an alias must be declared below a non alias option.\n");
+    if(words_len < 1)
+        return 0;
 
-            options_array[options_len].parameters = last_option.parameters;
-            options_array[options_len].argq = last_option.argq;
-            options_array[options_len].description = "Alias for the above option ^^";
-        }
-        else
-        {
-            last_option = options_array[options_len];
-        }
-        
+    if(cursor < 1 || cursor > words_len)
+        cursor = words_len;
 
-        // Save default and registered options in strings
-        if(options_len < DEFAULT_OPTIONS_LENGTH)
-            strcat_char(options_default_ptr, options_array[options_len].key);
-        else
-            strcat_char(options_registered_ptr, options_array[options_len].key);
+    memset(passed, 0, sizeof(passed));
 
+    return complete_walk(NULL, NULL, parser, passed, words, 1, cursor, (cursor < words_len) ? words[cursor] : "", 1, out); // queries from the same process reuse the trie
+}
 
-        options_len++;
-    }
 
+
+/**
+ * @brief Releases a parser made by "cmdf_parser_create".
+ */
+void cmdf_parser_free(cmdf_parser *parser)
+{
+    if(parser == NULL)
+        return;
+
+    if(parser->allocator.free == NULL) // generated parsers are static data
+        return;
+
+    cmdf_allocator allocator = parser->allocator;
+
+    options_table_free(parser);
+    allocator_free(&allocator, parser);
 }
 
 
 
 /**
- * @brief Receives an option an call user define option parser function upon the arguments that succed the option
- * @param argv: Array of strings of arguments from command line. 
- * @param count: Pointer to int counter of arguments from argv. 
- * @param current_option: Struct with the current option information. 
- * @param user_parser_function: User defined parser function to parser the options. 
- * @param extern_user_variables_struct: Pointer to user defined struct. 
- * @param flags: Flags used for the error handler function. 
+ * @brief Makes a tree of commands, nothing is compiled until a command line selects a command.
  */
-void option_parser(int argc, char **argv, int *count, cmdf_option *current_option, option_parse_function user_parse_function, void *extern_user_variables_struct, cmdf_option *registered_options, char *default_options, PARSER_FLAGS_Typedef flags)
+cmdf_command_tree *cmdf_command_tree_create(cmdf_command *root, PARSER_FLAGS_Typedef flags)
 {
-    int arguments_to_take = current_option->argq;
-    char *current_argument = NULL;
-    int arg_counter = 0;
-    int i = 0;
+    cmdf_command_tree *tree = allocator_calloc(&default_allocator, 1, sizeof(*tree));
 
-    if(arguments_to_take == 0)          // -------------- take no arguments
-    {
-        if(strchr(default_options,current_option->key) == NULL)    // user option
-            user_parse_function(current_option->key, NULL, arg_counter, extern_user_variables_struct); // call with NULL on argument;
-        else                                                        // default option
-            default_options_parser(current_option->key, registered_options, flags);
+    if(tree == NULL)
+        return NULL;
 
+    tree->root = root;
+    tree->flags = flags;
+    tree->mask = COMMAND_TREE_MIN_SLOTS - 1;
+    tree->entries = allocator_calloc(&default_allocator, COMMAND_TREE_MIN_SLOTS, sizeof(*tree->entries));
 
-        return;
-    }
-    else if(arguments_to_take == -1)    // -------------- take as many arguments as possible                            
+    if(tree->entries == NULL)
     {
+        allocator_free(&default_allocator, tree);
+        return NULL;
+    }
 
-        if((*count) < (argc - 1)) // to prevent for acessing undesirable memory beyond the argv array
-            (*count)++;
-        
-        current_argument = argv[*count];
+    pthread_mutex_init(&(tree->lock), NULL);
 
-        if(current_argument[0] == '-') // and option was given after the current one
-        {
-            if(current_option->parameters & OPTION_NO_CHAR_KEY)
-                error_handler_parse_options_internal(flags, "The option --%s needs at least one valid argument.\n", current_option->long_name);
-            else
-                error_handler_parse_options_internal(flags, "The option -%c / --%s needs at least one valid argument.\n", current_option->key, current_option->long_name);
+    return tree;
+}
 
-            return;
-        }
 
-        while(current_argument[0] != '-') // until another option comes
-        {
-            if(strchr(default_options, current_option->key) == NULL) // if the current option is not a default option
-                user_parse_function(current_option->key, current_argument, arg_counter, extern_user_variables_struct);
-            else
-                default_options_parser(current_option->key, registered_options, flags);
 
+/**
+ * @brief Parses a command line with a tree of commands, compiling the parsers of the selected commands on first use.
+ */
+int cmdf_command_tree_parse(const cmdf_command_tree *tree, int argc, char **argv, void *extern_user_variables_struct, cmdf_result *result, const cmdf_command **command)
+{
+    cmdf_command_path root = {tree->root, NULL, tree->root->parse_function};
+    const cmdf_command *selected;
+    const cmdf_parser *parser = command_tree_parser_get(tree, NULL, &root);
+    cmdf_parse_state state;
 
-            arg_counter++; // each new argument to the option has a index given by arg_counter
-            
-            if((*count) < (argc - 1)) // to prevent for acessing undesirable memory beyond the argv array
-                (*count)++; // read next on argv
-            else 
-                return; // exit function after all cmd arguments have been read 
+    if(command != NULL)
+        *command = tree->root;
 
-            current_argument = argv[*count];
-        }
+    if(parser == NULL)
+    {
+        memset(result, 0, sizeof(*result));
+        error_handler_parse_options_internal(result, tree->flags, PARSER_ERROR_OUT_OF_MEMORY, -1, NULL, "No memory for the options of the program.\n");
+        return PARSER_ERROR_OUT_OF_MEMORY;
+    }
 
-        (*count)--; // goes back by one, because we need to re read the new option
+    // options with registration errors are not parsed, the errors are reported again instead
+    *result = parser->registration_result;
 
-        return;
+    if(result->error_count > 0 || parse_wide_keys_check(parser, root.parse_function != NULL, result) != 0)
+        return result->errors[0].code;
 
-    }
-    else if(arguments_to_take > 0)      // -------------- take "n" arguments  
-    {
+    complete_main(tree, &root, parser, argc, argv);
 
-        if((*count) < (argc - 1)) // to prevent for acessing undesirable memory beyond the argv array
-            (*count)++;
-        
-        while( (argv[*count] != NULL) && ((current_argument = argv[*count])[0] != '-') ) // until another option comes or the end of argv
-        {
-            if(strchr(default_options,current_option->key) == NULL) // if the current option is not a default option
-                user_parse_function(current_option->key, current_argument, arg_counter, extern_user_variables_struct);
-            else
-                default_options_parser(current_option->key, registered_options, flags);
-          
-            (*count)++;
+    unsigned long options_passed_bitset[parser->bitset_words];
 
-            arg_counter++; // each new argument to the option has a index given by arg_counter            
-        }
+    parse_state_begin(&state, parser, root.parse_function, extern_user_variables_struct, result, options_passed_bitset, 1);
 
-        if(arg_counter > arguments_to_take)
-        {
-            if(current_option->parameters & OPTION_NO_CHAR_KEY)
-                error_handler_parse_options_internal(flags, "The option --%s has too many arguments, it only receives \"%i\" many.\n", current_option->long_name,current_option->argq);
-            else
-                error_handler_parse_options_internal(flags, "The option -%c / --%s has too many arguments, it only receives \"%i\" many.\n",current_option->key,current_option->long_name,current_option->argq);
-        }
-        else if(arg_counter < arguments_to_take)
-        {
-            if(current_option->parameters & OPTION_NO_CHAR_KEY)
-                error_handler_parse_options_internal(flags, "The option --%s has too few arguments, it expects at least \"%i\".\n",current_option->long_name,current_option->argq);
-            else
-                error_handler_parse_options_internal(flags, "The option -%c / --%s has too few arguments, it expects at least \"%i\".\n",current_option->key,current_option->long_name,current_option->argq);
-        }
+    int error = command_parse(tree, &state, &root, argc, argv, &selected);
 
-        (*count)--; // goes back by one, because we need to re read the new option
+    if(command != NULL)
+        *command = selected;
 
+    return error;
+}
+
+
+
+/**
+ * @brief Releases a tree of commands and its parsers.
+ */
+void cmdf_command_tree_free(cmdf_command_tree *tree)
+{
+    if(tree == NULL)
         return;
-    }
-    else
+
+    for(unsigned int slot = 0; slot <= tree->mask; slot++)
     {
-        error_handler_parse_options_internal(flags, "The option --%s was registered with invalid number of argument: (%i). It should be, -1, 0 or bigger than 0.\n", arguments_to_take);
-        return;
+        if(tree->entries[slot].command != NULL)
+            cmdf_parser_free(tree->entries[slot].parser);
     }
 
+    pthread_mutex_destroy(&(tree->lock));
+    allocator_free(&default_allocator, tree->entries);
+    allocator_free(&default_allocator, tree);
 }
 
 
 
-/* -------------------------------------------- Functions Implementations ---------------------------------------------- */
+/**
+ * @brief Gets the statistics of the last parse made by the calling thread.
+ */
+void cmdf_stats_get(cmdf_stats *stats)
+{
+#if defined(CMDF_ENABLE_STATS)
+    *stats = stats_current;
+#else
+    memset(stats, 0, sizeof(*stats));
+#endif
+}
+
 
 
 /**
- * @brief Set default value of cmdf_default_info_usage
+ * @brief Expands the response files of a command line.
  */
-void set_cmdf_default_info_usage(const char *info_string)
+int cmdf_args_expand(cmdf_args *args, int argc, char **argv, const cmdf_allocator *allocator)
 {
-    cmdf_default_info_usage = info_string;
+    int error = PARSER_ERROR_NONE;
+    int i;
+
+    memset(args, 0, sizeof(*args));
+    args->allocator = (allocator != NULL) ? *allocator : default_allocator;
+
+    for(i = 0; i < argc && error == PARSER_ERROR_NONE; i++)
+    {
+        if(i > 0 && argv[i][0] == '@' && argv[i][1] != '\0') // the program name is never a response file
+            error = response_file_expand(args, argv[i] + 1, 1);
+        else if(args_append(args, argv[i]) != 0)
+            error = PARSER_ERROR_OUT_OF_MEMORY;
+    }
+
+    return error;
 }
 
 
 
 /**
- * @brief Set default value of cmdf_default_info_version
+ * @brief Splits a command string in arguments, in place.
  */
-void set_cmdf_default_info_version(const char *info_string)
+int cmdf_args_tokenize(cmdf_args *args, char *command, const cmdf_allocator *allocator)
 {
-    cmdf_default_info_version = info_string;
+    char *cursor = command;
+    char *end = command + strlen(command);
+    char *token;
+    int literal;
+
+    memset(args, 0, sizeof(*args));
+    args->allocator = (allocator != NULL) ? *allocator : default_allocator;
+
+    while((token = command_token_next(&cursor, end, &literal, 1)) != NULL)
+    {
+        if(args_append(args, token) != 0)
+            return PARSER_ERROR_OUT_OF_MEMORY;
+    }
+
+    return PARSER_ERROR_NONE;
 }
 
 
 
 /**
- * @brief Set default value of cmdf_default_info_contact
+ * @brief Releases expanded arguments.
  */
-void set_cmdf_default_info_contact_info(const char *info_string)
+void cmdf_args_free(cmdf_args *args)
 {
-    cmdf_default_info_contact_info = info_string;
+    cmdf_args_mapping *mappings = (cmdf_args_mapping*)args->mappings;
+    int i;
+
+    for(i = 0; i < args->mappings_len; i++)
+        response_file_unload(args, &(mappings[i]));
+
+    allocator_free(&(args->allocator), mappings);
+    allocator_free(&(args->allocator), args->argv);
+
+    args->mappings = NULL;
+    args->mappings_len = 0;
+    args->mappings_capacity = 0;
+    args->argv = NULL;
+    args->argc = 0;
+    args->argv_capacity = 0;
 }
 
 
@@ -566,129 +5898,44 @@ void set_cmdf_default_info_contact_info(const char *info_string)
  */
 int cdmf_parse_options(cmdf_option *registered_options, option_parse_function user_parse_function, int argc, char **argv, PARSER_FLAGS_Typedef flags, void *extern_user_variables_struct)
 {
-    if(argc >= MAX_CMD_ARGUMENTS)
-        error_handler_parse_options_internal(flags, "The maximum number of (%d) arguments was passed.\n", MAX_CMD_ARGUMENTS);
-
-    int i = 0, j = 0, k= 0;
-    int x = -1, y = 0;
-
-    char current_key = 0;
-    char* current_argument;
-    int current_key_arg_counter = -1; // in case of first coming arguments with no set key, they will be processed until a key arrives
-    
-    char options_required_matrix[0xFF][0xFF] = {0};          // required options with respective aliases
-    char options_default_array[0xFF] = {0};             // default options given by the library
-    char options_registered_array[0xFF] = {0};          // all the non default options
-    char options_passed_array[0xFF] = {0};   // the options given on the cmd
-
-    parse_registered_options(&registered_options, flags, options_required_matrix, options_registered_array, options_default_array);
+    cmdf_parser *parser = cmdf_parser_create(registered_options, flags);
 
-    cmdf_option *current_option = NULL;
-
-    // run for every argument passed on cmd
-    i = 1; // to the first cmd argument after the programs name
-    while(i < argc) 
+    if(parser == NULL)
     {
-        current_argument = argv[i];
-
-        if(current_argument[0]=='-' && current_argument[1]=='-')            // ------------- long name option
-        {
-
-            current_argument += 2; // remove the "--" in the beginning
-            current_option = get_option_by_long_name(current_argument,registered_options);
-
-            if(current_option == NULL) // option is not registered
-            {
-                if (flags & PARSER_FLAG_DONT_IGNORE_NON_REGISTERED_OPTIONS)
-                    error_handler_parse_options_internal(flags, "The option --%s is invalid!\n", current_argument);
-                
-
-                if(i < argc) // to prevent for acessing undesirable memory beyond the argv array
-                {
-                    i++;
-                    continue; // ignore if the error handler above doesn't exit the program
-                }
-                else
-                    break; // exit from while
-            }
-
-            strcat_char(options_passed_array, current_option->key); // remember option
-
-            if(current_option->parameters & OPTION_NO_LONG_KEY) // long name of the option is not to be used
-            {
-                if(i < argc) // to prevent for acessing undesirable memory beyond the argv array
-                {
-                    i++;
-                    continue;
-                }
-                else
-                    break; // exit from while
+        error_handler_parse_options_internal(NULL, flags, PARSER_ERROR_OUT_OF_MEMORY, -1, NULL, "Not enough memory to prepare the options.\n");
+        return PARSER_ERROR_OUT_OF_MEMORY;
+    }
 
-            }
+    if(flags & PARSER_FLAG_EXPAND_RESPONSE_FILES)
+    {
+        cmdf_args *expanded = malloc(sizeof(*expanded)); // never released, the arguments live as long as the program, just as argv
 
-            option_parser(argc, argv, &i, current_option, user_parse_function, extern_user_variables_struct, registered_options, options_default_array, flags);
+        int error = (expanded != NULL) ? cmdf_args_expand(expanded, argc, argv, NULL) : PARSER_ERROR_OUT_OF_MEMORY;
 
-        }
-        else if(current_argument[0]=='-')                                   // ------------- char key option
+        if(error != PARSER_ERROR_NONE)
         {
-            
-            current_argument += 1; // jump over the "-" 
-
-            j = 0;
-            while(current_argument[j] != '\0') // for every letter in option
-            {
-                current_option = get_option_by_key(current_argument[j], registered_options);
-
-                if(current_option == NULL) // option is not registered
-                {
-                    if (flags & PARSER_FLAG_DONT_IGNORE_NON_REGISTERED_OPTIONS)
-                        error_handler_parse_options_internal(flags, "The option -%s is invalid!\n", current_argument);
-                    
-                    j++;
-                    continue; // ignore if the error handler above doesn't exit the program
-                }
-
-                if( (strlen(current_argument) > 1) && (current_option->argq != 0) ) // check for when nested options come, trown an error if one of then requires an argument. only no argument options can be nested.
-                    error_handler_parse_options_internal(flags, "Only nested options can be nested in a single \"-\". Nested options passed: -%s , Option that requires arguments: -%c.\n",current_argument,current_option->key);
-
-                strcat_char(options_passed_array, current_option->key); // remember option
-
-                option_parser(argc, argv, &i, current_option, user_parse_function, extern_user_variables_struct, registered_options, options_default_array, flags);
+            if(error == PARSER_ERROR_RESPONSE_FILE)
+                error_handler_parse_options_internal(NULL, flags, error, -1, NULL, "The response file %s could not be read.\n", expanded->error_path);
+            else
+                error_handler_parse_options_internal(NULL, flags, error, -1, NULL, "Not enough memory to expand the response files.\n");
 
-                j++;
-            }
+            if(expanded != NULL)
+                cmdf_args_free(expanded);
 
-        }
-        else                                                                // ------------- floating argument
-        {
-            user_parse_function(0, current_argument, i, extern_user_variables_struct); // pass alone argument with the 0 key
+            free(expanded);
+            cmdf_parser_free(parser);
+            return error;
         }
 
-        i++;
+        argc = expanded->argc;
+        argv = expanded->argv;
     }
 
-    // check for required options if no default option was called
-    if(strpbrk(options_passed_array, options_default_array) == NULL)
-    {
-        i = 0;
-        while(options_required_matrix[i][0] != '\0')
-        {
-            if(strpbrk(options_passed_array,options_required_matrix[i]) == NULL)
-            {
-                cmdf_option *required_option = get_option_by_key(options_required_matrix[i][0], registered_options);
-
-                if(required_option->parameters & OPTION_NO_CHAR_KEY)
-                    error_handler_parse_options_internal(flags, "The --%s option needs to be specified.\n", required_option->long_name);
-                else
-                    error_handler_parse_options_internal(flags, "The option -%c / --%s needs to be specified.\n",required_option->key,required_option->long_name);
-            }
-
-            i++;
-        }
-    }
+    int error = cmdf_parser_parse(parser, user_parse_function, argc, argv, extern_user_variables_struct);
 
+    cmdf_parser_free(parser);
 
-    return 0;
+    return error;
 }
 
 #ifdef __cplusplus 
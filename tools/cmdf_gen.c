@@ -0,0 +1,447 @@
+/**
+ * Parser tables generator for the library CMD Friend.
+ *
+ * Compiles an options spec at build time and writes the tables of its parser as static C data, so the program
+ * does no table construction at startup and the registration errors of the spec stop the build.
+ *
+ * The spec is a header defining the X-macro "CMDF_SPEC_OPTIONS", one X() per option with the same fields of a
+ * "cmdf_option", the binding and the environment variable being optional, the name of the parser in "CMDF_SPEC_NAME"
+ * and optionally its flags in "CMDF_SPEC_FLAGS":
+ *
+ *      #define CMDF_SPEC_NAME app_parser
+ *      #define CMDF_SPEC_FLAGS PARSER_FLAG_DONT_IGNORE_NON_REGISTERED_OPTIONS
+ *      #define CMDF_SPEC_OPTIONS(X) \
+ *          X("window", 'w', OPTION_OPTIONAL, 1, "Window name") \
+ *          X("win",    'W', OPTION_ALIAS,    0, NULL) \
+ *          X("tags",   't', OPTION_OPTIONAL, -1, "Tags to put in") \
+ *          X("jobs",   'j', OPTION_OPTIONAL, 1, "Parallel jobs", CMDF_BIND_INT(struct app_args, jobs, 1, 64)) \
+ *          X("color",  'c', OPTION_OPTIONAL, 1, "Color mode", {0}, "APP_COLOR")
+ *
+ * With PARSER_FLAG_WIDE_KEYS in the flags the options with OPTION_NO_CHAR_KEY need no key, "cmdf_parser_parse_wide" gives
+ * them by their id, which is given after the environment variable or else is "CMDF_AUTO_ID" of their index in the spec:
+ *
+ *      X("feature-x", 0, OPTION_OPTIONAL | OPTION_NO_CHAR_KEY, 0, "Feature x", {0}, NULL, 1001)
+ *
+ * The constraints between the options can be given as well in "CMDF_SPEC_CONSTRAINTS", one X() per "cmdf_constraint",
+ * they are compiled to bitsets here and a constraint that names an unknown option stops the build:
+ *
+ *      #define CMDF_SPEC_CONSTRAINTS(X) \
+ *          X(CONSTRAINT_EXCLUSIVE, "window tags")
+ *
+ * Build and run with "make gen SPEC=app_spec.h OUT=app_parser", which writes "app_parser.c" and "app_parser.h".
+ * The program then includes "app_parser.h", compiles "app_parser.c" and parses with "cmdf_parser_parse(app_parser, ...)".
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "../src/cmdf.c"
+
+#ifndef CMDF_SPEC
+#error "Define CMDF_SPEC as the quoted path of the options spec, as in -DCMDF_SPEC='\"app_spec.h\"'"
+#endif
+
+#include CMDF_SPEC
+
+#if !defined(CMDF_SPEC_NAME) || !defined(CMDF_SPEC_OPTIONS)
+#error "The options spec must define CMDF_SPEC_NAME and CMDF_SPEC_OPTIONS"
+#endif
+
+#ifndef CMDF_SPEC_FLAGS
+#define CMDF_SPEC_FLAGS 0
+#endif
+
+#define GEN_STRINGIFY_VALUE(x) #x
+#define GEN_STRINGIFY(x) GEN_STRINGIFY_VALUE(x)
+
+
+/* Spec ----------------------------------------------------------------------------------- */
+
+
+#define GEN_SPEC_OPTION(long_name, key, parameters, argq, ...) {long_name, key, parameters, argq, __VA_ARGS__},
+#define GEN_SPEC_KEY_CASE(long_name, key, parameters, argq, ...) case GEN_SPEC_CASE_KEY(key, parameters):
+
+// with PARSER_FLAG_WIDE_KEYS the options without a char key don't use their key, each gets a case value of its own
+#define GEN_SPEC_CASE_KEY(key, parameters) ((((CMDF_SPEC_FLAGS) & PARSER_FLAG_WIDE_KEYS) && ((parameters) & OPTION_NO_CHAR_KEY)) ? -1 - __COUNTER__ : (key))
+
+static cmdf_option spec_options[] = {CMDF_SPEC_OPTIONS(GEN_SPEC_OPTION) {0}};
+
+#ifdef CMDF_SPEC_CONSTRAINTS
+#define GEN_SPEC_CONSTRAINT(kind, options) {kind, options},
+
+static const cmdf_constraint spec_constraints[] = {CMDF_SPEC_CONSTRAINTS(GEN_SPEC_CONSTRAINT) {0}};
+#endif
+
+
+// never called, duplicated keys in the spec are duplicated case values and fail to compile, ids are checked by the registration
+static void spec_static_checks(int key)
+{
+    switch(key)
+    {
+        CMDF_SPEC_OPTIONS(GEN_SPEC_KEY_CASE)
+        case __HELP_KEY:
+        case __VERSION_KEY:
+        case __INFO_KEY:
+        default:
+            break;
+    }
+}
+
+
+/* Writers -------------------------------------------------------------------------------- */
+
+
+// writes a string as a C literal, or NULL
+static void gen_string(FILE *out, const char *string)
+{
+    if(string == NULL)
+    {
+        fputs("NULL", out);
+        return;
+    }
+
+    fputc('"', out);
+
+    for(; *string != '\0'; string++)
+    {
+        unsigned char c = (unsigned char)*string;
+
+        if(c == '"' || c == '\\')
+            fprintf(out, "\\%c", c);
+        else if(c == '\n')
+            fputs("\\n", out);
+        else if(c == '\t')
+            fputs("\\t", out);
+        else if(c < 0x20 || c >= 0x7F)
+            fprintf(out, "\\%03o", c);
+        else
+            fputc(c, out);
+    }
+
+    fputc('"', out);
+}
+
+
+// writes a bitset array
+static void gen_words(FILE *out, const char *type_name, const char *name, const unsigned long *words, size_t count)
+{
+    fprintf(out, "static %s %s_%s[%zu] = {", type_name, GEN_STRINGIFY(CMDF_SPEC_NAME), name, (count > 0) ? count : 1);
+
+    for(size_t i = 0; i < count; i++)
+        fprintf(out, "%s0x%lxUL", (i > 0) ? ", " : "", words[i]);
+
+    fprintf(out, "%s};\n\n", (count > 0) ? "" : "0");
+}
+
+
+// renders the options list of --help, just as the parser would
+static char *gen_help_text(const cmdf_parser *parser)
+{
+    size_t length;
+
+    return help_render(parser, &default_allocator, &length);
+}
+
+
+static void gen_source(FILE *out, const cmdf_parser *parser, const char *header_name)
+{
+    const char *name = GEN_STRINGIFY(CMDF_SPEC_NAME);
+    const cmdf_long_name_index *index = &(parser->long_name_index);
+    char *help_text = gen_help_text(parser);
+    int i;
+
+    fprintf(out, "/* Parser tables of \"%s\", generated from \"%s\" by tools/cmdf_gen.c, do not edit. */\n\n", name, CMDF_SPEC);
+    fprintf(out, "#include \"cmdf_tables.h\"\n#include \"%s\"\n\n\n", header_name);
+
+    // names of enum bindings, aliases share the list of their option
+    for(i = 0; i < parser->options_len; i++)
+    {
+        const char *const *names = parser->options[i].binding.names;
+
+        if(names == NULL || (i > 0 && parser->options[i - 1].binding.names == names))
+            continue;
+
+        fprintf(out, "static const char *const %s_names_%d[] = {", name, i);
+
+        for(int n = 0; names[n] != NULL; n++)
+        {
+            gen_string(out, names[n]);
+            fputs(", ", out);
+        }
+
+        fputs("NULL};\n\n", out);
+    }
+
+    // options, after the registration filled the aliases
+    fprintf(out, "static cmdf_option %s_options[%d] =\n{\n", name, parser->options_len + 1);
+
+    for(i = 0; i < parser->options_len; i++)
+    {
+        const cmdf_option *option = &(parser->options[i]);
+        const cmdf_binding *binding = &(option->binding);
+        int names_index = i;
+
+        while(names_index > 0 && binding->names != NULL && parser->options[names_index - 1].binding.names == binding->names)
+            names_index--;
+
+        fputs("    {", out);
+        gen_string(out, option->long_name);
+        fprintf(out, ", %d, 0x%x, %d, ", option->key, (unsigned int)option->parameters, option->argq);
+        gen_string(out, option->description);
+        fprintf(out, ", {(BINDINGS_Typedef)%d, %zu, %zu, %lldLL, %lldLL, ", (int)binding->action, binding->offset, binding->size, binding->min, binding->max);
+
+        if(binding->names != NULL)
+            fprintf(out, "%s_names_%d}, ", name, names_index);
+        else
+            fputs("NULL}, ", out);
+
+        gen_string(out, option->env_name);
+        fprintf(out, ", %ld},\n", (long)option->id);
+    }
+
+    fputs("    {0}\n};\n\n", out);
+
+    // long name index
+    fprintf(out, "static cmdf_option *%s_long_name_slots[%u] =\n{\n", name, index->mask + 1);
+
+    for(unsigned int slot = 0; slot <= index->mask; slot++)
+    {
+        if(index->slots[slot] != NULL)
+            fprintf(out, "    [%u] = &%s_options[%d],\n", slot, name, (int)(index->slots[slot] - parser->options));
+    }
+
+    fputs("};\n\n", out);
+
+    fprintf(out, "static unsigned int %s_long_name_hashes[%u] =\n{\n", name, index->mask + 1);
+
+    for(unsigned int slot = 0; slot <= index->mask; slot++)
+    {
+        if(index->slots[slot] != NULL)
+            fprintf(out, "    [%u] = 0x%08xU,\n", slot, index->hashes[slot]);
+    }
+
+    fputs("};\n\n", out);
+
+    fprintf(out, "static size_t %s_long_name_lengths[%u] =\n{\n", name, index->mask + 1);
+
+    for(unsigned int slot = 0; slot <= index->mask; slot++)
+    {
+        if(index->slots[slot] != NULL)
+            fprintf(out, "    [%u] = %zu,\n", slot, index->lengths[slot]);
+    }
+
+    fputs("};\n\n", out);
+
+    // long name trie, with PARSER_FLAG_ALLOW_ABBREVIATIONS or PARSER_FLAG_ENABLE_COMPLETION
+    if(parser->name_trie.nodes != NULL)
+    {
+        const cmdf_name_trie *trie = &(parser->name_trie);
+
+        fprintf(out, "static cmdf_name_trie_node %s_name_trie_nodes[%u] =\n{\n", name, trie->nodes_len);
+
+        for(unsigned int node = 0; node < trie->nodes_len; node++)
+        {
+            const cmdf_name_trie_node *current = &(trie->nodes[node]);
+
+            fprintf(out, "    {%u, %u, %u, %u, %d, %d},\n", current->label, current->label_length, current->children, current->children_len, current->exact, current->prefix);
+        }
+
+        fputs("};\n\n", out);
+
+        // the chars of every node, ended by the '\0' left after the last one
+        fprintf(out, "static char %s_name_trie_labels[] = ", name);
+        gen_string(out, trie->labels);
+        fputs(";\n\n", out);
+    }
+
+    // required bitmasks
+    gen_words(out, "unsigned long", "default_mask", parser->default_mask, (size_t)parser->bitset_words);
+    gen_words(out, "unsigned long", "required_masks", parser->required_masks, (size_t)parser->required_len * parser->bitset_words);
+
+    fprintf(out, "static int %s_required_options[%d] = {", name, (parser->required_len > 0) ? parser->required_len : 1);
+
+    for(i = 0; i < parser->required_len; i++)
+        fprintf(out, "%s%d", (i > 0) ? ", " : "", parser->required_options[i]);
+
+    fprintf(out, "%s};\n\n", (parser->required_len > 0) ? "" : "0");
+
+    // options with an environment variable
+    fprintf(out, "static int %s_env_options[%d] = {", name, (parser->env_options_len > 0) ? parser->env_options_len : 1);
+
+    for(i = 0; i < parser->env_options_len; i++)
+        fprintf(out, "%s%d", (i > 0) ? ", " : "", parser->env_options[i]);
+
+    fprintf(out, "%s};\n\n", (parser->env_options_len > 0) ? "" : "0");
+
+    // constraints and their bitsets
+    if(parser->constraints_len > 0)
+    {
+        int members_len = 0;
+
+        fprintf(out, "static cmdf_constraint_check %s_constraints[%d] =\n{\n", name, parser->constraints_len);
+
+        for(i = 0; i < parser->constraints_len; i++)
+        {
+            const cmdf_constraint_check *check = &(parser->constraints[i]);
+
+            fprintf(out, "    {(CONSTRAINTS_Typedef)%d, %d, %d, %d, %d, %d},\n", (int)check->kind, check->subject, check->members, check->members_len, check->first_word, check->words);
+            members_len = check->members + check->members_len;
+        }
+
+        fputs("};\n\n", out);
+
+        gen_words(out, "unsigned long", "constraint_masks", parser->constraint_masks, (size_t)parser->constraints_len * parser->bitset_words);
+
+        fprintf(out, "static int %s_constraint_members[%d] = {", name, members_len);
+
+        for(i = 0; i < members_len; i++)
+            fprintf(out, "%s%d", (i > 0) ? ", " : "", parser->constraint_members[i]);
+
+        fputs("};\n\n", out);
+
+        fprintf(out, "static int %s_aliases[%d] = {", name, (parser->aliases_len > 0) ? parser->aliases_len : 1);
+
+        for(i = 0; i < parser->aliases_len; i++)
+            fprintf(out, "%s%d", (i > 0) ? ", " : "", parser->aliases[i]);
+
+        fprintf(out, "%s};\n\n", (parser->aliases_len > 0) ? "" : "0");
+    }
+
+    // the parser
+    fprintf(out, "static cmdf_parser %s_tables =\n{\n", name);
+    fprintf(out, "    .flags = (PARSER_FLAGS_Typedef)0x%x,\n", (unsigned int)parser->flags);
+    fprintf(out, "    .options = %s_options,\n", name);
+    fprintf(out, "    .options_len = %d,\n", parser->options_len);
+    fputs("    .key_map =\n    {\n", out);
+
+    for(i = 0; i < KEY_MAP_LENGTH; i++)
+    {
+        if(parser->key_map[i] != NULL)
+            fprintf(out, "        [%d] = &%s_options[%d],\n", i, name, (int)(parser->key_map[i] - parser->options));
+    }
+
+    fputs("    },\n", out);
+    fprintf(out, "    .long_name_index = {%s_long_name_slots, %s_long_name_hashes, %s_long_name_lengths, 0x%xU},\n", name, name, name, index->mask);
+
+    if(parser->name_trie.nodes != NULL)
+        fprintf(out, "    .name_trie = {%s_name_trie_nodes, %s_name_trie_labels, %uU},\n", name, name, parser->name_trie.nodes_len);
+
+    fprintf(out, "    .bitset_words = %d,\n", parser->bitset_words);
+    fprintf(out, "    .default_mask = %s_default_mask,\n", name);
+    fprintf(out, "    .required_masks = %s_required_masks,\n", name);
+    fprintf(out, "    .required_options = %s_required_options,\n", name);
+    fprintf(out, "    .required_len = %d,\n", parser->required_len);
+    fprintf(out, "    .env_options = %s_env_options,\n", name);
+    fprintf(out, "    .env_options_len = %d,\n", parser->env_options_len);
+
+    if(parser->constraints_len > 0)
+    {
+        fprintf(out, "    .constraints = %s_constraints,\n", name);
+        fprintf(out, "    .constraints_len = %d,\n", parser->constraints_len);
+        fprintf(out, "    .constraint_masks = %s_constraint_masks,\n", name);
+        fprintf(out, "    .constraint_members = %s_constraint_members,\n", name);
+        fprintf(out, "    .aliases = %s_aliases,\n", name);
+        fprintf(out, "    .aliases_len = %d,\n", parser->aliases_len);
+    }
+
+    fputs("    .help_text = ", out);
+    gen_string(out, help_text);
+    fputs(",\n};\n\n", out);
+
+    fprintf(out, "cmdf_parser *const %s = &%s_tables;\n", name, name);
+
+    free(help_text);
+}
+
+
+static void gen_header(FILE *out)
+{
+    const char *name = GEN_STRINGIFY(CMDF_SPEC_NAME);
+
+    fprintf(out, "/* Parser \"%s\", generated from \"%s\" by tools/cmdf_gen.c, do not edit. */\n\n", name, CMDF_SPEC);
+    fprintf(out, "#ifndef __CMD_FRIEND_GENERATED_%s\n#define __CMD_FRIEND_GENERATED_%s\n\n", name, name);
+    fputs("#include \"cmdf.h\"\n\n", out);
+    fputs("#ifdef __cplusplus\nextern \"C\" {\n#endif\n\n", out);
+    fputs("/**\n", out);
+    fprintf(out, " * @brief Parser with static tables, ready to be used by any parse function. Never needs \"cmdf_parser_free\".\n");
+    fputs(" */\n", out);
+    fprintf(out, "extern cmdf_parser *const %s;\n\n", name);
+    fputs("#ifdef __cplusplus\n}\n#endif\n\n#endif\n", out);
+}
+
+
+/* Main ----------------------------------------------------------------------------------- */
+
+
+int main(int argc, char **argv)
+{
+    char source_path[FILENAME_MAX], header_path[FILENAME_MAX];
+    const char *header_name;
+    cmdf_parser *parser;
+    FILE *source, *header;
+
+    (void)spec_static_checks;
+
+    if(argc < 2)
+    {
+        fprintf(stderr, "usage: %s OUTPUT_BASE_PATH\n", argv[0]);
+        return 1;
+    }
+
+    snprintf(source_path, sizeof(source_path), "%s.c", argv[1]);
+    snprintf(header_path, sizeof(header_path), "%s.h", argv[1]);
+
+    header_name = strrchr(header_path, '/');
+    header_name = (header_name != NULL) ? header_name + 1 : header_path;
+
+    // the same checks made at runtime, printed and not exiting so every error of the spec is reported
+    parser = cmdf_parser_create(spec_options, (CMDF_SPEC_FLAGS) | PARSER_FLAG_NOT_EXIT_ON_ERROR | PARSER_FLAG_PRINT_ERRORS_STDERR);
+
+    if(parser == NULL)
+    {
+        fprintf(stderr, "%s: not enough memory\n", CMDF_SPEC);
+        return 1;
+    }
+
+    if(parser->registration_result.error_count > 0)
+    {
+        fprintf(stderr, "%s: %d registration errors in the options spec\n", CMDF_SPEC, parser->registration_result.error_count);
+        cmdf_parser_free(parser);
+        return 1;
+    }
+
+#ifdef CMDF_SPEC_CONSTRAINTS
+    if(cmdf_parser_set_constraints(parser, spec_constraints) != PARSER_ERROR_NONE)
+    {
+        fprintf(stderr, "%s: invalid constraints in the options spec\n", CMDF_SPEC);
+        cmdf_parser_free(parser);
+        return 1;
+    }
+#endif
+
+    parser->flags = (PARSER_FLAGS_Typedef)(CMDF_SPEC_FLAGS); // the generated parser keeps only the flags of the spec
+
+    if((parser->flags & PARSER_FLAG_ENABLE_COMPLETION) && name_trie_get(parser) == NULL) // completions start from the trie already built
+    {
+        fprintf(stderr, "%s: not enough memory\n", CMDF_SPEC);
+        return 1;
+    }
+
+    source = fopen(source_path, "w");
+    header = fopen(header_path, "w");
+
+    if(source == NULL || header == NULL)
+    {
+        fprintf(stderr, "cannot write %s and %s\n", source_path, header_path);
+        return 1;
+    }
+
+    gen_source(source, parser, header_name);
+    gen_header(header);
+
+    fclose(source);
+    fclose(header);
+    cmdf_parser_free(parser);
+
+    return 0;
+}